@@ -6,10 +6,10 @@
 #include <map>
 #include <queue>
 #include <functional>
-#include <random>
 #include <chrono>
 #include "Player.h"
 #include "Team.h"
+#include "RandomStream.h"
 
 // Forward declaration
 class AuctionVisualizer;
@@ -186,8 +186,7 @@ private:
     bool aiBiddingEnabled;
     std::map<std::string, BiddingStrategy> aiStrategies;
     std::map<std::string, float> aiAggression;
-    std::random_device randomDevice;
-    std::mt19937 randomGenerator;
+    RandomStream randomGenerator;
     
     // Visualization
     std::shared_ptr<AuctionVisualizer> visualizer;
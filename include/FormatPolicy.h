@@ -0,0 +1,86 @@
+#pragma once
+
+#include <utility>
+
+enum class MatchType {
+    TEST,
+    ODI,
+    T20
+};
+
+// Compile-time rules for each format. The engine's ball loop is instantiated
+// once per policy, so limits are constants and rules a format does not have
+// compile away. MaxOvers and MaxBowlerOvers are per innings; 0 means no limit.
+// Rain rules apply where MinOversForResult, the overs the chasing side must
+// face for a result, is set; AverageInningsScore scales targets when rain
+// leaves the chasing side more resources than the side batting first had.
+struct T20Policy {
+    static constexpr MatchType Type = MatchType::T20;
+    static constexpr int MaxInnings = 2;
+    static constexpr int MaxOvers = 20;
+    static constexpr int MaxWickets = 10;
+    static constexpr int MaxBowlerOvers = 4;
+    static constexpr int PowerplayOvers = 6;
+    static constexpr bool IsTimed = false;
+    static constexpr int MinOversForResult = 5;
+    static constexpr int AverageInningsScore = 160;
+};
+
+struct ODIPolicy {
+    static constexpr MatchType Type = MatchType::ODI;
+    static constexpr int MaxInnings = 2;
+    static constexpr int MaxOvers = 50;
+    static constexpr int MaxWickets = 10;
+    static constexpr int MaxBowlerOvers = 10;
+    static constexpr int PowerplayOvers = 10;
+    static constexpr bool IsTimed = false;
+    static constexpr int MinOversForResult = 20;
+    static constexpr int AverageInningsScore = 245;
+};
+
+// Innings are unlimited; the match ends when its days run out
+struct TestPolicy {
+    static constexpr MatchType Type = MatchType::TEST;
+    static constexpr int MaxInnings = 4;
+    static constexpr int MaxOvers = 0;
+    static constexpr int MaxWickets = 10;
+    static constexpr int MaxBowlerOvers = 0;
+    static constexpr int PowerplayOvers = 0;
+    static constexpr bool IsTimed = true;
+    static constexpr int MinOversForResult = 0;
+    static constexpr int AverageInningsScore = 0;
+
+    static constexpr int Days = 5;
+    static constexpr int SessionsPerDay = 3;
+    static constexpr int OversPerDay = 90;
+    static constexpr int FollowOnMargin = 200;
+    static constexpr int DayBalls = OversPerDay * 6;
+    static constexpr int SessionBalls = DayBalls / SessionsPerDay;
+    static constexpr int MatchBalls = Days * DayBalls;
+};
+
+// One over a side with two wickets, to settle a tied limited-overs match
+struct SuperOverPolicy {
+    static constexpr MatchType Type = MatchType::T20;
+    static constexpr int MaxInnings = 2;
+    static constexpr int MaxOvers = 1;
+    static constexpr int MaxWickets = 2;
+    static constexpr int MaxBowlerOvers = 1;
+    static constexpr int PowerplayOvers = 0;
+    static constexpr bool IsTimed = false;
+    static constexpr int MinOversForResult = 0;
+    static constexpr int AverageInningsScore = 0;
+};
+
+// Call function with the policy object for a format; the one runtime branch
+template <typename Function>
+decltype(auto) DispatchFormat(MatchType type, bool superOver, Function&& function) {
+    if (superOver) {
+        return std::forward<Function>(function)(SuperOverPolicy{});
+    }
+    switch (type) {
+        case MatchType::T20: return std::forward<Function>(function)(T20Policy{});
+        case MatchType::ODI: return std::forward<Function>(function)(ODIPolicy{});
+        default: return std::forward<Function>(function)(TestPolicy{});
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+// Instruction sets the lockstep kernel can run on
+enum class SimdLevel {
+    AUTO,   // best level this build and CPU support
+    SCALAR,
+    AVX2,   // 8 matches per instruction stream
+    AVX512  // 16 matches per instruction stream
+};
+
+// A range of limited-overs matches between two fixed line-ups. Outcome
+// tables are flattened into threshold/alias columns so lanes can gather them.
+struct LockstepJob {
+    const uint32_t* thresholds; // [table * BallResultCount + column]
+    const uint32_t* aliases;
+    uint32_t tableBase[2];      // first table of each batting side
+    uint32_t bowlers[2];        // bowling order length facing each side
+    uint32_t wicketLimit[2];    // wickets that end each side's innings
+    uint32_t maxOvers;
+    uint64_t seed;              // MatchEngine random seed for the batch
+    uint32_t firstMatch;        // match index of the first match in the range
+    uint32_t matchCount;
+    uint16_t* firstInningsRuns;  // [matchCount], filled in by Run
+    uint16_t* secondInningsRuns;
+};
+
+// Score-only simulator that advances many independent matches together, one
+// SIMD lane per match, in structure-of-arrays layout. Each delivery draws from
+// the same stream and outcome table as MatchEngine, so match i of a job ends
+// with exactly the score the scalar engine gives match index i.
+class LockstepKernel {
+public:
+    static SimdLevel GetSupportedLevel();
+    static const char* GetLevelName(SimdLevel level);
+    static int GetLaneCount(SimdLevel level);
+
+    // Unsupported levels fall back to the best supported one below them
+    static void Run(const LockstepJob& job, SimdLevel level = SimdLevel::AUTO);
+};
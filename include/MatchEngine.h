@@ -3,16 +3,17 @@
 #include "Player.h"
 #include "Team.h"
 #include "Venue.h"
+#include "NameTable.h"
+#include "RandomStream.h"
+#include "LockstepKernel.h"
+#include "FormatPolicy.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <random>
-
-enum class MatchType {
-    TEST,
-    ODI,
-    T20
-};
+#include <map>
+#include <array>
 
 enum class MatchFormat {
     FIRST_INNINGS,
@@ -20,6 +21,23 @@ enum class MatchFormat {
     SUPER_OVER
 };
 
+// How much detail the engine records while simulating. SCORE_ONLY keeps
+// innings totals and the result only: no ball log, commentary, callbacks or
+// player stats. Both levels draw from the same model and random streams.
+enum class SimulationFidelity {
+    FULL,
+    SCORE_ONLY
+};
+
+// Pace of a live match driven by Update(). BROADCAST bowls a ball every
+// BroadcastSecondsPerBall of frame time, FAST ten times quicker, and INSTANT
+// as many balls as the per-frame simulation budget allows.
+enum class PlaybackSpeed {
+    BROADCAST,
+    FAST,
+    INSTANT
+};
+
 enum class BallResult {
     DOT_BALL,
     SINGLE,
@@ -82,6 +100,87 @@ struct BallEvent {
     FieldingPosition fieldingPosition;
     bool isExtra;
     std::string commentary;
+    double winProbability;        // batting side after this ball, -1 if unknown
+    bool winProbabilityIsCurrent; // false when it is the latest older estimate
+};
+
+// Compact per-delivery record: the engine's primary ball log.
+// Names are resolved through the engine's NameTable only when asked for.
+struct BallRecord {
+    PlayerId striker;
+    PlayerId nonStriker;
+    PlayerId bowler;
+    PlayerId fielder;
+    uint16_t over;           // over within the innings (0-based)
+    uint8_t ball;            // legal balls already bowled in the over
+    uint8_t innings;         // innings index (0-based)
+    uint8_t result;          // BallResult
+    uint8_t runs;
+    uint8_t wicketType;      // WicketType, meaningful when IsWicket()
+    uint8_t fieldingPosition; // FieldingPosition
+    
+    BallResult GetResult() const { return static_cast<BallResult>(result); }
+    WicketType GetWicketType() const { return static_cast<WicketType>(wicketType); }
+    bool IsWicket() const { return GetResult() == BallResult::WICKET || GetResult() == BallResult::RUN_OUT; }
+    bool IsLegal() const { return GetResult() != BallResult::WIDE && GetResult() != BallResult::NO_BALL; }
+    bool IsExtra() const {
+        BallResult r = GetResult();
+        return r == BallResult::WIDE || r == BallResult::NO_BALL || r == BallResult::BYE || r == BallResult::LEG_BYE;
+    }
+};
+
+static_assert(sizeof(BallRecord) == 16, "BallRecord should stay one 16-byte slot");
+
+// Append-only ball log stored in fixed-size chunks. Copying a log shares the
+// chunks already written; a chunk is only copied when a shared copy appends to it.
+class BallLog {
+public:
+    static constexpr size_t ChunkSize = 256;
+    
+    class const_iterator {
+    public:
+        const_iterator(const BallLog* log, size_t index) : log(log), index(index) {}
+        const BallRecord& operator*() const { return (*log)[index]; }
+        const BallRecord* operator->() const { return &(*log)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+    private:
+        const BallLog* log;
+        size_t index;
+    };
+    
+    size_t Size() const { return count; }
+    bool Empty() const { return count == 0; }
+    const BallRecord& operator[](size_t index) const { return (*chunks[index / ChunkSize])[index % ChunkSize]; }
+    const BallRecord& Back() const { return (*this)[count - 1]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    
+    void Append(const BallRecord& ball);
+    void Clear();
+    
+private:
+    using Chunk = std::array<BallRecord, ChunkSize>;
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    size_t count = 0;
+};
+
+constexpr int BallResultCount = static_cast<int>(BallResult::RUN_OUT) + 1;
+
+// Alias-method table over ball results. One 32-bit draw picks a column with
+// its high bits and chooses between the column and its alias with the rest.
+struct OutcomeTable {
+    std::array<uint32_t, BallResultCount> threshold;
+    std::array<uint8_t, BallResultCount> alias;
+    
+    void Build(const std::array<double, BallResultCount>& weights);
+    BallResult Sample(uint32_t draw) const {
+        uint64_t scaled = static_cast<uint64_t>(draw) * BallResultCount;
+        uint32_t column = static_cast<uint32_t>(scaled >> 32);
+        uint32_t fraction = static_cast<uint32_t>(scaled);
+        return static_cast<BallResult>(fraction < threshold[column] ? column : alias[column]);
+    }
 };
 
 struct Over {
@@ -107,21 +206,104 @@ struct Innings {
     bool isComplete;
 };
 
+// Running totals for one innings, updated ball by ball
+struct InningsTotals {
+    int runs;
+    int wickets;
+    int legalBalls;
+    int extras;
+    int battingSide; // 0 = team1
+};
+
+// One player's batting and bowling line in one innings of the current match.
+// Accumulated ball by ball; byes and leg byes are not charged to the bowler,
+// and run outs do not count as the bowler's wickets.
+struct PlayerMatchStats {
+    uint16_t runs;
+    uint16_t ballsFaced;      // every delivery but wides
+    uint16_t fours;
+    uint16_t sixes;
+    uint16_t ballsBowled;     // legal deliveries
+    uint16_t runsConceded;
+    PlayerId dismissedBy;     // the bowler; NoPlayer for a run out
+    uint8_t howOut;           // WicketType, when dismissed
+    uint8_t maidens;
+    uint8_t wickets;
+    bool dismissed;
+    
+    int GetOvers() const { return ballsBowled / 6; }
+    double GetStrikeRate() const { return ballsFaced > 0 ? runs * 100.0 / ballsFaced : 0.0; }
+    double GetEconomy() const { return ballsBowled > 0 ? runsConceded * 6.0 / ballsBowled : 0.0; }
+};
+
+// A batter's share of a partnership, and their innings so far
+struct PartnershipBatter {
+    PlayerId id;
+    uint16_t runs;
+    uint16_t balls;
+    uint16_t inningsRuns;
+    uint16_t inningsBalls;
+};
+
+struct Partnership {
+    PartnershipBatter batters[2]; // [0] was already in, unless both opened
+    uint16_t runs;                // extras included
+    uint16_t legalBalls;
+    uint16_t startRuns;           // team score when the pair came together
+};
+
+struct FallOfWicket {
+    PlayerId batter;
+    uint16_t runs;       // team score when the wicket fell
+    uint16_t legalBalls; // into the innings
+    uint16_t batterRuns;
+    uint16_t batterBalls;
+};
+
+// Partnerships and fall of wickets for one innings, kept up ball by ball in
+// fixed storage. The last partnership is in progress while the innings is.
+struct InningsProgress {
+    static constexpr int MaxWickets = 10;
+    
+    std::array<Partnership, MaxWickets> partnerships;
+    std::array<FallOfWicket, MaxWickets> fallOfWickets;
+    uint8_t partnershipCount;
+    uint8_t wicketCount;
+    
+    bool HasCurrentPartnership() const { return partnershipCount > wicketCount; }
+    const Partnership& GetCurrentPartnership() const { return partnerships[partnershipCount - 1]; }
+};
+
+// A rain stoppage in a limited-overs innings and what it left the innings
+// with. Logged as the match goes so a replay can apply it without drawing.
+struct RainInterruption {
+    uint16_t over;          // overs completed in the innings when play stopped
+    uint8_t innings;
+    uint8_t oversLost;      // the innings' total after the stoppage
+    uint16_t resourcesLost; // likewise, in resource table units
+    uint16_t target;        // revised target; 0 in the first innings
+};
+
 struct MatchState {
     MatchType matchType;
     MatchFormat format;
     int currentInnings;
     int currentOver;
     int currentBall;
-    std::string striker;
-    std::string nonStriker;
-    std::string bowler;
-    std::string fieldingTeam;
-    std::string battingTeam;
-    std::string bowlingTeam;
+    PlayerId striker;
+    PlayerId nonStriker;
+    PlayerId bowler;
+    TeamId battingTeam; // 0 = team1, 1 = team2
+    TeamId bowlingTeam;
     bool isMatchComplete;
-    std::string winner;
-    std::string result;
+    TeamId winner;      // NoTeam while undecided, tied or drawn
+    bool isTie;
+    bool isDraw;        // Tests only: time ran out
+    bool isNoResult;    // limited overs: rain left too few overs for a result
+    int winMargin;      // runs or wickets, see wonByRuns
+    bool wonByRuns;
+    bool wonByInnings;  // Tests only: winMargin is the innings-and-runs margin
+    bool wonBySuperOver; // winMargin is the super over margin
 };
 
 struct PitchConditions {
@@ -144,8 +326,69 @@ struct WeatherConditions {
     int visibility; // 1-10
 };
 
+// Expected contribution of a single player across a batch of simulations
+struct PlayerExpectation {
+    std::string team;
+    double expectedRuns;
+    double expectedBallsFaced;
+    double expectedWickets;
+};
+
+// State handed to the renderer at the end of each Update(). It is only
+// rebuilt between simulation steps, so it never shows half a delivery.
+struct RenderState {
+    MatchState state;
+    InningsTotals totals;     // current innings
+    int target;               // 0 in the first innings; revised after rain
+    int parScore;             // chasing side's par on the resource table, 0 in the first innings
+    int currentInningsIndex;
+    uint32_t ballCount;       // balls in the log
+    BallRecord lastBall;      // valid when ballCount > 0
+    float stepProgress;       // 0-1 towards the next ball, for interpolation
+    bool isPowerplay;
+    bool hasPartnership;
+    Partnership partnership;  // the pair at the crease, when hasPartnership
+};
+
+// Points at which a resumable match hands control back, weakest first. A
+// step that ends an over also ends a ball, and so on up.
+enum class MatchBoundary : uint8_t {
+    NONE,    // paused, or nothing bowled yet
+    BALL,
+    OVER,
+    INNINGS,
+    MATCH
+};
+
+// Aggregate results from a batch of independent match simulations
+struct BatchSimulationResult {
+    int simulations;
+    int team1Wins;
+    int team2Wins;
+    int ties;
+    int draws;     // Tests that ran out of time
+    int noResults;
+    double team1WinPercentage;
+    double team2WinPercentage;
+    double tiePercentage;
+    double drawPercentage;
+    double team1AverageScore;
+    double team2AverageScore;
+    std::vector<int> team1ScoreDistribution; // index = total runs, value = match count
+    std::vector<int> team2ScoreDistribution;
+    std::map<std::string, PlayerExpectation> playerExpectations;
+};
+
+struct ReplayCheckpoint;
+class MatchReplay;
+class MatchEventBus;
+class WinProbabilityEngine;
+enum class MatchEventType : uint8_t;
+
 class MatchEngine {
 public:
+    static constexpr int MaxInnings = 4;
+    
     MatchEngine();
     ~MatchEngine();
     
@@ -153,6 +396,26 @@ public:
     void InitializeMatch(Team* team1, Team* team2, Venue* venue, MatchType type);
     void SetPitchConditions(const PitchConditions& conditions);
     void SetWeatherConditions(const WeatherConditions& conditions);
+    void SetSimulationFidelity(SimulationFidelity level) { fidelity = level; }
+    SimulationFidelity GetSimulationFidelity() const { return fidelity; }
+    
+    // Limited-overs ties go to a super over when enabled
+    void EnableSuperOver(bool enabled) { superOverOnTie = enabled; }
+    bool IsSuperOverEnabled() const { return superOverOnTie; }
+    
+    // Rain in limited-overs matches. Before each over play is held up with
+    // chancePerOver for an exponentially distributed delay; the overs lost
+    // come off both innings while the first side bats, and the chase target
+    // is revised from the resource table. Off by default. Set before the
+    // first ball to have the start of the match checked too.
+    static constexpr int RainMinutesPerOver = 4;
+    void SetRainRisk(double chancePerOver, int meanDelayMinutes, int delayedStartMinutes = 0);
+    void SetRainRiskFromVenue(); // from the venue's current weather
+    bool IsRainEnabled() const { return rainChance > 0 || rainDelayedStartMinutes > 0; }
+    bool IsRainAffected() const { return rainResourcesLost[0] > 0 || rainResourcesLost[1] > 0; }
+    const std::vector<RainInterruption>& GetRainInterruptions() const { return rainInterruptions; }
+    int GetAllottedOvers(int inningsIndex) const; // 0 in Tests
+    int GetParScore() const; // runs the chasing side should have now; 0 in the first innings
     
     // Match simulation
     void SimulateBall();
@@ -160,21 +423,170 @@ public:
     void SimulateInnings();
     void SimulateMatch();
     
+    // Resumable form of SimulateMatch: play on until the next boundary at
+    // least as strong as `until` and return the one reached. The engine
+    // holds all of the match's state between calls, so one thread can keep
+    // any number of matches in flight (see MatchScheduler). The result is
+    // the same as SimulateMatch however the calls are split.
+    MatchBoundary Advance(MatchBoundary until = MatchBoundary::BALL);
+    
+    // Tests are played in sessions (see TestPolicy). Other formats treat the
+    // whole innings as one session.
+    void SimulateSession();
+    
+    // Skip the rest of the session statistically, one partnership at a time,
+    // from the batters' outcome rates against the attack. For matches nobody
+    // is watching: skipped balls are not logged, so the match can no longer
+    // be saved as a replay.
+    void FastForwardSession();
+    int GetDay() const;     // 1-based; Tests only
+    int GetSession() const; // 1-based within the day; Tests only
+    
+    // Batch simulation: runs independent copies of the initialized match across
+    // worker threads (0 = hardware concurrency) and aggregates the results.
+    // Results depend only on the seed and match index, not on the thread count.
+    BatchSimulationResult SimulateBatch(int numSimulations, unsigned int numThreads = 0) const;
+    
+    // Score-only batch on the lockstep SIMD kernel. Wins and score distributions
+    // match SimulateBatch exactly; player expectations are left empty. Tests,
+    // super overs, rain and line-ups the kernel cannot take fall back to
+    // SimulateBatch.
+    BatchSimulationResult SimulateLockstepBatch(int numSimulations, unsigned int numThreads = 0,
+                                                SimdLevel level = SimdLevel::AUTO) const;
+    
+    // Random streams are keyed by (seed, match index, innings, delivery).
+    // InitializeMatch derives the index from the fixture; set it afterwards
+    // to tell repeats of one fixture apart.
+    void SetRandomSeed(uint64_t seed);
+    void SetMatchIndex(uint32_t index) { matchIndex = index; }
+    uint32_t GetMatchIndex() const { return matchIndex; }
+    
+    // Complete mutable state of a match in progress. The ball log is shared
+    // with the engine it came from, so taking a snapshot does not copy it.
+    struct Snapshot {
+        MatchState state;
+        std::array<InningsTotals, MaxInnings> inningsTotals;
+        std::vector<Innings> innings;
+        BallLog ballHistory;
+        std::vector<PlayerMatchStats> playerStats;
+        std::array<InningsProgress, MaxInnings> inningsProgress;
+        int overRunsCharged;
+        std::array<uint8_t, 2> rainOversLost;
+        std::array<uint16_t, 2> rainResourcesLost;
+        std::vector<RainInterruption> rainInterruptions;
+        int battingSide;
+        int nextBatterIndex;
+        int bowlerIndex;
+        int target;
+        int currentInningsIndex;
+        int deliveryIndex; // together with the seed and match index, the RNG position
+        int pitchWear;
+        int pitchDrying;
+        bool isInningsComplete;
+        bool isMatchComplete;
+        bool hasSkippedBalls;
+        uint64_t randomSeed;
+        uint32_t matchIndex;
+    };
+    
+    // Snapshots and forks for what-if lookahead. Restoring rebuilds ball
+    // commentary from the log; manual commentary lines are dropped.
+    Snapshot TakeSnapshot() const;
+    void RestoreSnapshot(const Snapshot& snapshot);
+    
+    // Score-level position of a match in progress, fixed in size: totals,
+    // who is in, the target, the RNG position and rain, but no player lines,
+    // partnerships or ball log. Enough for a SCORE_ONLY engine to play on.
+    struct ScoreState {
+        std::array<InningsTotals, MaxInnings> inningsTotals;
+        std::array<uint8_t, 2> rainOversLost;
+        std::array<uint16_t, 2> rainResourcesLost;
+        PlayerId striker;
+        PlayerId nonStriker;
+        PlayerId bowler;
+        int currentOver;
+        int currentBall;
+        int battingSide;
+        int nextBatterIndex;
+        int bowlerIndex;
+        int target;
+        int currentInningsIndex;
+        int deliveryIndex;
+        int pitchWear;
+        int pitchDrying;
+        bool isInningsComplete;
+        uint64_t randomSeed;
+        uint32_t matchIndex;
+    };
+    
+    ScoreState TakeScoreState() const;
+    void RestoreScoreState(const ScoreState& state);
+    
+    // Independent engine continuing from the current state, with no callbacks.
+    // Branch 0 replays the live match's random streams; other values give
+    // independent futures. Line-ups, names and outcome tables are shared.
+    std::unique_ptr<MatchEngine> Fork(uint64_t branch = 0) const;
+    
+    // What-if steps for lookahead: play a chosen result for the current ball,
+    // and the compact key win probability estimates are cached under
+    void ApplyBallOutcome(BallResult outcome);
+    uint64_t GetWinStateKey() const;
+    
+    // Binary replay: seed, line-up and venue fingerprints, every ball record,
+    // the rain interruptions and a state checkpoint each checkpointInterval
+    // balls. Checkpoints carry the player lines and partnerships too, so a
+    // shorter interval buys cheaper seeks with a larger file.
+    bool SaveReplay(const std::string& path, int checkpointInterval = 24) const;
+    
+    // Rebuild the state after the first ballCount balls of a replay from its
+    // nearest checkpoint and the records after it, without drawing random
+    // numbers. Earlier records are only read if the ball log is asked for.
+    // The engine must be initialized with the same teams and venue.
+    bool LoadReplay(MatchReplay& replay, uint32_t ballCount);
+    bool LoadReplay(const std::string& path, uint32_t ballCount = UINT32_MAX);
+    
+    // Live win probability, estimated off the simulation thread after each
+    // ball and reported on BallEvent. States already seen come from a cache.
+    void EnableWinProbability(bool enabled, int simulationsPerState = 200);
+    bool IsWinProbabilityEnabled() const { return winProbability != nullptr; }
+    
     // Match state
     const MatchState& GetMatchState() const { return matchState; }
     const std::vector<Innings>& GetInnings() const { return innings; }
-    const std::vector<BallEvent>& GetBallHistory() const { return ballHistory; }
+    const BallLog& GetBallHistory() const; // reads in any records a replay seek left on disk
+    
+    // Name resolution for compact records
+    const std::string& GetPlayerName(PlayerId id) const { return names->GetName(id); }
+    std::shared_ptr<const NameTable> GetNameTable() const { return names; }
+    const std::string& GetTeamName(TeamId id) const;
+    const Venue* GetVenue() const { return venue; }
+    const std::vector<PlayerId>& GetBattingOrder(int side) const { return lineups[side].batting; }
+    const std::vector<PlayerId>& GetBowlingOrder(int side) const { return lineups[side].bowling; }
+    BallEvent ResolveBallEvent(const BallRecord& ball) const;
+    std::string GetResultDescription() const;
     
-    // Current state queries
+    // Current state queries (current innings only)
+    const InningsTotals& GetCurrentInningsTotals() const { return inningsTotals[currentInningsIndex]; }
+    const InningsTotals& GetInningsTotals(int inningsIndex) const { return inningsTotals[inningsIndex]; }
     int GetCurrentScore() const;
     int GetCurrentWickets() const;
     double GetCurrentRunRate() const;
     int GetRequiredRuns() const;
     int GetRemainingOvers() const;
+    bool IsPowerplay() const;
     
-    // Player performance
-    void UpdatePlayerStats(const BallEvent& event);
-    std::map<std::string, PlayerStats> GetPlayerMatchStats() const;
+    // Player performance. Lines are kept at FULL fidelity for logged balls
+    // only; fast-forwarded stretches are not credited to anyone.
+    void UpdatePlayerStats(const BallRecord& ball);
+    const PlayerMatchStats& GetPlayerInningsLine(int inningsIndex, PlayerId id) const {
+        return playerStats[inningsIndex * players.size() + id];
+    }
+    PlayerMatchStats GetPlayerMatchLine(PlayerId id) const; // all innings added up
+    std::map<std::string, PlayerStats> GetPlayerMatchStats() const; // builds the map on every call
+    
+    // Partnerships and fall of wickets, kept with the ball log
+    const InningsProgress& GetInningsProgress(int inningsIndex) const { return inningsProgress[inningsIndex]; }
+    const InningsProgress& GetCurrentInningsProgress() const { return inningsProgress[currentInningsIndex]; }
     
     // Tactical decisions
     void SetFieldingPositions(const std::map<std::string, FieldingPosition>& positions);
@@ -186,16 +598,29 @@ public:
     void ResumeMatch();
     void EndMatch();
     bool IsMatchPaused() const { return isPaused; }
+    bool IsMatchComplete() const { return isMatchComplete; }
+    
+    // Real-time pacing: Update() advances the live match on a fixed timestep
+    // and never simulates for longer than the frame budget per call
+    static constexpr float BroadcastSecondsPerBall = 30.0f;
+    void SetPlaybackSpeed(PlaybackSpeed speed);
+    void SetPlaybackMultiplier(float multiplier); // 1 = broadcast pace, 0 = instant
+    float GetPlaybackMultiplier() const { return playbackMultiplier; }
+    void SetFrameBudget(float milliseconds) { frameBudgetMs = milliseconds; }
+    const RenderState& GetRenderState() const { return renderState; }
     
     // Update method
     void Update(float deltaTime);
     
-    // Commentary and events
+    // Commentary and events. Ball commentary is generated from the ball log
+    // only when read, so simulating never builds commentary strings.
     void AddCommentary(const std::string& commentary);
-    const std::vector<std::string>& GetCommentary() const { return commentary; }
+    const std::vector<std::string>& GetCommentary() const;
     void ClearCommentary();
+    std::string DescribeBall(const BallRecord& ball) const;
     
-    // Statistics
+    // Statistics. The scorecard strings are conveniences over ScorecardWriter,
+    // which renders into a reusable buffer without allocating.
     void CalculateMatchStats();
     std::string GenerateScorecard() const;
     std::string GenerateMatchReport() const;
@@ -205,48 +630,173 @@ public:
     void SetInningsEndCallback(std::function<void(const Innings&)> callback);
     void SetMatchEndCallback(std::function<void(const std::string&)> callback);
     
+    // Asynchronous fan-out: ball, innings and match events are queued to the
+    // bus instead of calling subscribers on the simulation thread
+    void SetEventBus(std::shared_ptr<MatchEventBus> bus);
+    const std::shared_ptr<MatchEventBus>& GetEventBus() const { return eventBus; }
+    
 private:
+    // Batting and bowling line-ups resolved from a team at match start
+    struct TeamLineup {
+        std::vector<PlayerId> batting;
+        std::vector<PlayerId> bowling;
+    };
+    
     // Match data
     Team* team1;
     Team* team2;
     Venue* venue;
     MatchType matchType;
+    bool superOverOnTie;
+    TeamLineup lineups[2];
+    std::shared_ptr<NameTable> names;
+    std::vector<Player*> players; // indexed by PlayerId
+    
+    // Batter-vs-bowler outcome tables, indexed batter * players.size() + bowler.
+    // Rebuilt lazily after line-ups or conditions change; shared with forks.
+    std::shared_ptr<const std::vector<OutcomeTable>> outcomeTables;
+    bool outcomeTablesDirty;
     
     // Match state
     MatchState matchState;
+    int battingSide; // 0 = team1 batting, 1 = team2 batting
+    int nextBatterIndex;
+    int bowlerIndex;
+    int target;
+    bool isInningsComplete;
+    int currentInningsIndex;
+    int deliveryIndex; // deliveries bowled in the current innings, extras included
+    std::array<InningsTotals, MaxInnings> inningsTotals;
     std::vector<Innings> innings;
-    std::vector<BallEvent> ballHistory;
-    std::vector<std::string> commentary;
+    mutable BallLog ballHistory;
+    mutable std::vector<std::string> commentary;
+    mutable size_t describedBalls; // logged balls already in commentary
+    
+    // After a replay seek, the records before replayPrefixBalls stay on disk
+    // and ballHistory starts after them until something needs the whole log
+    mutable std::unique_ptr<MatchReplay> replayPrefix;
+    mutable uint32_t replayPrefixBalls;
+    std::vector<PlayerMatchStats> playerStats; // innings * players.size() + PlayerId
+    std::array<InningsProgress, MaxInnings> inningsProgress;
+    int overRunsCharged; // to the bowler so far this over; none makes a maiden
     
     // Conditions
     PitchConditions pitchConditions;
     WeatherConditions weatherConditions;
+    int pitchWear; // wear added to pitchConditions.wear during this match
+    int pitchDrying; // moisture lost from pitchConditions.moisture, likewise
+    bool hasSkippedBalls; // a session was fast-forwarded
+    
+    // Rain. Settings are kept in the units a replay header stores them in.
+    uint16_t rainChance; // per over, in hundredths of a percent
+    uint8_t rainDelayMinutes; // mean delay when it rains
+    uint8_t rainDelayedStartMinutes;
+    std::array<uint8_t, 2> rainOversLost; // per main innings
+    std::array<uint16_t, 2> rainResourcesLost; // resource table units
+    std::vector<RainInterruption> rainInterruptions; // this match's, saved with replays
+    const std::vector<RainInterruption>* recordedRain; // while replaying: used instead of drawing
     
     // Control
+    SimulationFidelity fidelity;
     bool isPaused;
     bool isMatchComplete;
     
+    // Real-time pacing
+    float playbackMultiplier;
+    float frameBudgetMs;
+    double stepAccumulator; // frame time not yet turned into balls
+    RenderState renderState;
+    
     // Callbacks
     std::function<void(const BallEvent&)> ballEventCallback;
     std::function<void(const Innings&)> inningsEndCallback;
     std::function<void(const std::string&)> matchEndCallback;
+    std::shared_ptr<MatchEventBus> eventBus;
+    
+    // Background win probability; null when disabled
+    std::unique_ptr<WinProbabilityEngine> winProbability;
     
     // Random number generation
-    std::random_device rd;
-    std::mt19937 gen;
+    uint64_t randomSeed;
+    uint32_t matchIndex;
+    RandomStream random; // stream for the delivery being simulated
+    
+    // Format-specialized simulation; the public entry points pick the policy
+    // once and stay inside one instantiation for the rest of the call
+    template <typename Format> void SimulateMatchFor();
+    template <typename Format> void SimulateInningsFor();
+    template <typename Format> void SimulateBallFor();
+    template <typename Format> void UpdateMatchStateFor(const BallRecord& ball);
+    template <typename Format> void CheckInningsEndFor();
+    template <typename Format> void CheckForRainFor();
+    template <typename Format> void ApplyRecordedRainFor();
+    template <typename Format> void StartRainInningsFor();
+    template <typename Format> int GetAllottedOversFor(int inningsIndex) const;
+    template <typename Format> int GetParFor(int resourcesUsed) const;
+    template <typename Format> bool IsNoResultFor() const;
+    template <typename Function> decltype(auto) WithInningsFormat(Function&& function) const {
+        return DispatchFormat(matchType, IsSuperOverInnings(), std::forward<Function>(function));
+    }
+    bool IsSuperOverInnings() const { return matchType != MatchType::TEST && currentInningsIndex >= 2; }
+    MatchFormat GetInningsFormat() const;
     
     // Helper methods
-    BallEvent SimulateBallResult();
+    void ResetMatch();
+    void AdvanceInnings();
+    bool IsResultDecided() const;
+    int GetNextBattingSide() const;
+    int GetTeamRuns(int side) const;
+    int GetMatchBallsBowled() const;
+    bool ShouldDeclare() const;
+    // A batter's per-legal-ball outcome rates against the current attack
+    struct SkipRates {
+        double wicket;
+        double runs;
+        double runsVariance;
+        double extraRuns;
+        double deliveries; // deliveries per legal ball; 0 until computed
+    };
+    const SkipRates& GetSkipRates(PlayerId batter, std::vector<SkipRates>& rates);
+    void SkipStretch(int ballsLeft, RandomStream& stream, std::vector<SkipRates>& rates);
+    void UpdateInningsProgress(const BallRecord& ball, PlayerId nextStriker, PlayerId nextNonStriker);
+    void OpenPartnership(InningsProgress& progress, PlayerId striker, PlayerId nonStriker);
+    void CreditPartnership(Partnership& partnership, PlayerId batter, int batterRuns, int ballsFaced);
+    void RecordFallOfWicket(InningsProgress& progress, PlayerId batter, int legalBalls);
+    MatchBoundary AdvanceLiveMatch();
+    void PublishRenderState();
+    void StartInnings(int side);
+    void EndInnings();
+    void BuildLineups();
+    TeamLineup BuildLineup(const Team* team);
+    void BuildOutcomeTables();
+    std::array<double, BallResultCount> CalculateOutcomeWeights(const Player* batsman, const Player* bowler);
+    void CopyConfigurationTo(MatchEngine& engine) const; // shared by Fork and batch workers
+    uint64_t GetBatchSeed() const;
+    uint64_t GetLineupFingerprint(int side) const;
+    uint64_t GetVenueFingerprint() const;
+    void ReplayBall(const BallRecord& ball);
+    ReplayCheckpoint MakeCheckpoint(uint32_t ball) const;
+    void ApplyCheckpoint(const ReplayCheckpoint& checkpoint);
+    BallRecord MakeBallRecord() const;
+    BallRecord SimulateBallResult();
+    void CatchUpCommentary() const;
+    void LoadBallHistoryPrefix() const;
+    size_t GetLoggedBallCount() const { return replayPrefixBalls + ballHistory.Size(); }
+    void ResetWinProbability();
+    void EstimateWinProbability(double& probability, bool& isCurrent);
+    void PublishEvent(MatchEventType type, const BallRecord* ball, double winProbability, bool winProbabilityIsCurrent);
     bool SimulateWicket();
     WicketType DetermineWicketType();
     int SimulateRuns();
     BallResult DetermineBallResult();
-    void UpdateMatchState(const BallEvent& event);
+    void UpdateMatchState(const BallRecord& ball);
     void SwitchStriker();
     void HandleWicket();
     void HandleExtra();
     void CalculateRequiredRuns();
     void DetermineMatchResult();
+    void DetermineTestResult();
+    void DetermineLimitedOversResult();
     
     // Probability calculations
     double CalculateBattingSuccessRate(const Player* batsman, const Player* bowler);
@@ -256,5 +806,6 @@ private:
     // Weather and pitch effects
     void ApplyWeatherEffects();
     void ApplyPitchEffects();
+    PitchConditions GetMatchPitch() const; // as worn and dried so far
     double GetPitchDifficulty();
 }; 
\ No newline at end of file
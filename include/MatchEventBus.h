@@ -0,0 +1,84 @@
+#pragma once
+
+#include "MatchEngine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class MatchEventType : uint8_t {
+    BALL,
+    INNINGS_END,
+    MATCH_END
+};
+
+// Fixed-size event, so publishing never allocates. Names are resolved by
+// subscribers through the engine's NameTable (MatchEngine::GetNameTable).
+struct MatchEvent {
+    MatchEventType type;
+    TeamId battingTeam;
+    TeamId winner;           // MATCH_END; NoTeam when tied
+    bool isTie;              // MATCH_END
+    bool wonByRuns;          // MATCH_END
+    bool winProbabilityIsCurrent;
+    uint16_t winMargin;      // MATCH_END
+    uint32_t matchIndex;
+    uint32_t sequence;       // per-bus publish order
+    BallRecord ball;         // BALL
+    InningsTotals totals;    // batting side, after the ball or at innings end
+    double winProbability;   // BALL; batting side, -1 if unknown
+};
+
+// Multi-subscriber fan-out for match events. Every subscriber owns a bounded
+// single-producer ring and a thread that drains it in batches, so the
+// publishing engine runs at its own pace. When a ring is full the event is
+// dropped for that subscriber and counted, unless it subscribed with
+// back-pressure, in which case Publish waits for space.
+class MatchEventBus {
+public:
+    using SubscriberId = uint32_t;
+    using Handler = std::function<void(const MatchEvent* events, size_t count)>;
+
+    struct SubscriberOptions {
+        size_t capacity = 1024;   // rounded up to a power of two
+        size_t maxBatch = 64;     // most events handed to one handler call
+        bool backPressure = false;
+    };
+
+    MatchEventBus();
+    ~MatchEventBus();
+
+    MatchEventBus(const MatchEventBus&) = delete;
+    MatchEventBus& operator=(const MatchEventBus&) = delete;
+
+    SubscriberId Subscribe(Handler handler, SubscriberOptions options);
+    SubscriberId Subscribe(Handler handler) { return Subscribe(std::move(handler), SubscriberOptions{}); }
+
+    // Delivers whatever is already queued, then stops the subscriber's thread.
+    // Handlers may call this, Subscribe and GetDroppedCount.
+    void Unsubscribe(SubscriberId id);
+
+    // Called from the simulation thread only
+    void Publish(const MatchEvent& event);
+
+    // Wait until every subscriber has handled everything queued for it
+    void Flush();
+
+    uint64_t GetDroppedCount(SubscriberId id) const;
+
+private:
+    struct Subscriber;
+
+    mutable std::mutex subscribersMutex;
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    SubscriberId nextId;
+    uint32_t nextSequence;
+    std::vector<std::shared_ptr<Subscriber>> publishing; // Publish's copy of the list
+
+    static void Run(std::shared_ptr<Subscriber> subscriber);
+    static void Stop(Subscriber& subscriber);
+};
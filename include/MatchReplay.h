@@ -0,0 +1,121 @@
+#pragma once
+
+#include "MatchEngine.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Innings totals as stored in a replay
+struct ReplayTotals {
+    uint16_t runs;
+    uint16_t legalBalls;
+    uint16_t extras;
+    uint8_t wickets;
+    uint8_t battingSide;
+};
+
+// Fixed-size file header. Fingerprints tie a replay to the line-ups and venue
+// it was played with, so it is only ever applied to the same match setup.
+struct ReplayHeader {
+    char magic[4];               // "CRPL"
+    uint16_t version;
+    uint16_t checkpointInterval; // balls between checkpoints
+    uint64_t randomSeed;
+    uint64_t team1Fingerprint;
+    uint64_t team2Fingerprint;
+    uint64_t venueFingerprint;
+    uint32_t matchIndex;
+    uint32_t ballCount;
+    uint32_t checkpointCount;
+    uint16_t winMargin;
+    uint8_t matchType;
+    uint8_t winner;
+    uint8_t isTie;
+    uint8_t wonByRuns;
+    uint8_t isMatchComplete;
+    uint8_t inningsCount;
+    ReplayTotals totals[MatchEngine::MaxInnings];
+    uint16_t rainChance;         // rain settings, as the engine keeps them
+    uint8_t rainDelayMinutes;
+    uint8_t rainDelayedStartMinutes;
+};
+
+// Engine state after the first `ball` records of the match
+struct ReplayCheckpoint {
+    uint32_t ball;
+    uint32_t deliveryIndex;
+    uint16_t currentOver;
+    uint8_t currentBall;
+    uint8_t currentInningsIndex;
+    PlayerId striker;
+    PlayerId nonStriker;
+    PlayerId bowler;
+    uint16_t target;
+    uint8_t battingSide;
+    uint8_t nextBatterIndex;
+    uint8_t bowlerIndex;
+    uint8_t isInningsComplete;
+    uint8_t pitchWear;
+    uint8_t pitchDrying;
+    uint8_t rainOversLost[2];
+    ReplayTotals totals[MatchEngine::MaxInnings];
+    uint16_t rainResourcesLost[2];
+};
+
+// Player lines and partnerships at a checkpoint, so seeking to it needs no
+// earlier records
+struct ReplayCheckpointState {
+    uint32_t overRunsCharged; // to the bowler in the over in progress, for maidens
+    std::vector<PlayerMatchStats> playerStats;
+    std::array<InningsProgress, MatchEngine::MaxInnings> inningsProgress;
+};
+
+static_assert(sizeof(ReplayHeader) == 96, "replay header layout is part of the file format");
+static_assert(sizeof(ReplayCheckpoint) == 64, "replay checkpoint layout is part of the file format");
+static_assert(sizeof(BallRecord) == 16, "ball record layout is part of the file format");
+static_assert(sizeof(PlayerMatchStats) == 18, "player line layout is part of the file format");
+static_assert(sizeof(InningsProgress) == 362, "innings progress layout is part of the file format");
+static_assert(sizeof(RainInterruption) == 8, "rain interruption layout is part of the file format");
+
+// Binary replay file: header, ball records, checkpoints, the rain
+// interruptions (a uint32 count, then the records), then each checkpoint's
+// state block (a uint32 line count, then per checkpoint the runs charged so
+// far in its over, player lines and innings progress). Opening a replay reads
+// only the header, checkpoints and rain; records and state blocks stay on
+// disk until asked for, so large archives can be scrubbed without loading
+// them. Files are written in host byte order (little-endian on every target).
+class MatchReplay {
+public:
+    static constexpr uint16_t Version = 1;
+
+    static bool Write(const std::string& path, const ReplayHeader& header, const BallLog& balls,
+                      const std::vector<ReplayCheckpoint>& checkpoints,
+                      const std::vector<RainInterruption>& rain,
+                      const std::vector<ReplayCheckpointState>& states);
+
+    bool Open(const std::string& path);
+    bool IsOpen() const { return file.is_open(); }
+    const std::string& GetPath() const { return path; }
+    const ReplayHeader& GetHeader() const { return header; }
+    uint32_t GetBallCount() const { return header.ballCount; }
+    const std::vector<RainInterruption>& GetRainInterruptions() const { return rain; }
+
+    // Latest checkpoint at or before the given ball, nullptr for the start
+    const ReplayCheckpoint* FindCheckpoint(uint32_t ball) const;
+
+    // State block of a checkpoint returned by FindCheckpoint
+    bool ReadCheckpointState(const ReplayCheckpoint& checkpoint, ReplayCheckpointState& out);
+
+    // Read `count` records starting at `first` into `out`
+    bool ReadBalls(uint32_t first, uint32_t count, std::vector<BallRecord>& out);
+
+private:
+    std::ifstream file;
+    std::string path;
+    ReplayHeader header{};
+    std::vector<ReplayCheckpoint> checkpoints;
+    std::vector<RainInterruption> rain;
+    std::streamoff statesOffset = 0; // where the state blocks begin
+    uint32_t stateLineCount = 0;     // player lines per state block
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "MatchEngine.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Interleaves any number of in-progress matches on the calling thread, for
+// views like a matchday's "around the grounds". Each Step moves every
+// unfinished match on to its next boundary, in the order they were added,
+// so fixtures advance in lockstep. Matches are not owned; they must outlive
+// the scheduler or be removed with Clear. Each match plays out exactly as
+// it would under SimulateMatch.
+class MatchScheduler {
+public:
+    // Called after each match's step with its slot and the boundary reached
+    using StepCallback = std::function<void(size_t slot, const MatchEngine& match, MatchBoundary reached)>;
+
+    size_t Add(MatchEngine* match); // returns the match's slot
+    void Clear();
+    void SetStepCallback(StepCallback callback) { stepCallback = std::move(callback); }
+
+    // One round over the unfinished matches. Returns how many are still in
+    // progress; paused matches stay in the rotation without advancing.
+    size_t Step(MatchBoundary until = MatchBoundary::BALL);
+
+    // Rounds until every match is over, or only paused ones are left
+    void Run(MatchBoundary until = MatchBoundary::OVER);
+
+    size_t GetMatchCount() const { return matches.size(); }
+    size_t GetActiveCount() const { return active.size(); }
+    MatchEngine* GetMatch(size_t slot) const { return matches[slot]; }
+
+private:
+    std::vector<MatchEngine*> matches;
+    std::vector<uint32_t> active; // slots still in progress, in slot order
+    size_t advancedLastStep = 0;  // matches that made progress in the last round
+    StepCallback stepCallback;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Dense integer handles used in place of names on hot paths
+using PlayerId = uint16_t;
+using TeamId = uint8_t;
+
+constexpr PlayerId NoPlayer = 0xFFFF;
+constexpr TeamId NoTeam = 0xFF;
+
+// Interning table that maps names to dense 16-bit ids and back.
+// Ids are assigned in insertion order and stay valid for the table's lifetime.
+class NameTable {
+public:
+    NameTable();
+    ~NameTable();
+    
+    uint16_t Intern(const std::string& name);
+    uint16_t Find(const std::string& name) const; // NoPlayer if the name is unknown
+    const std::string& GetName(uint16_t id) const;
+    size_t Size() const { return names.size(); }
+    void Clear();
+    
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint16_t> ids;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Simulation subsystems that draw random numbers. Each domain gets its own
+// key space so streams from different subsystems never overlap.
+enum class RandomDomain : uint8_t {
+    MATCH,
+    BATCH,
+    AUCTION,
+    TOURNAMENT,
+    WEATHER,
+    SEASON,
+    SQUAD,
+    PLAYER
+};
+
+// Counter-based Philox4x32-10 generator. A stream is fully determined by its
+// key and stream id, so constructing one costs nothing and the same
+// (key, stream) pair yields the same sequence on any thread.
+class RandomStream {
+public:
+    using result_type = uint32_t;
+
+    explicit RandomStream(uint64_t key = 0, uint64_t stream = 0)
+        : key{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)}
+        , counter{0, 0, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)}
+        , block{}
+        , index(4)
+    {
+    }
+
+    // UniformRandomBitGenerator, so <random> distributions work too
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() {
+        if (index == 4) {
+            Refill();
+        }
+        return block[index++];
+    }
+
+    // Uniform integer in [low, high]
+    int NextInt(int low, int high) {
+        uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(high) - low) + 1;
+        return low + static_cast<int>((static_cast<uint64_t>((*this)()) * range) >> 32);
+    }
+
+    // Uniform index in [0, count)
+    size_t NextIndex(size_t count) {
+        return static_cast<size_t>((static_cast<uint64_t>((*this)()) * count) >> 32);
+    }
+
+    // Uniform double in [0, 1)
+    double NextDouble() {
+        uint64_t bits = (static_cast<uint64_t>((*this)()) << 21) ^ ((*this)() >> 11);
+        return static_cast<double>(bits & ((1ULL << 53) - 1)) * (1.0 / 9007199254740992.0);
+    }
+
+    bool Chance(double probability) { return NextDouble() < probability; }
+
+private:
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 4> counter; // [0..1] block number, [2..3] stream id
+    std::array<uint32_t, 4> block;
+    int index;
+
+    void Refill() {
+        std::array<uint32_t, 4> x = counter;
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * x[0];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * x[2];
+            x = {static_cast<uint32_t>(p1 >> 32) ^ x[1] ^ k0, static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ x[3] ^ k1, static_cast<uint32_t>(p0)};
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        block = x;
+        index = 0;
+        if (++counter[0] == 0) {
+            ++counter[1];
+        }
+    }
+};
+
+// Process-wide seed shared by every subsystem. Streams are derived from the
+// seed, a domain and caller-chosen ids, so a fixed seed reproduces a run.
+class RandomService {
+public:
+    // Fix the base seed; without this a random one is drawn on first use
+    static void SetSeed(uint64_t seed);
+    static uint64_t GetSeed();
+
+    // Key for a domain under the current seed
+    static uint64_t GetDomainKey(RandomDomain domain);
+    static RandomStream GetStream(RandomDomain domain, uint64_t stream = 0);
+
+    // Stable 64-bit id for a name (FNV-1a), e.g. to key a venue's streams
+    static uint64_t HashName(const std::string& name);
+
+    // SplitMix64 finaliser, used to derive independent keys
+    static uint64_t Mix(uint64_t value);
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Batting resources left to a side, in hundredths of a percent of a full
+// innings, by balls left and wickets lost. Built at compile time for each
+// limited-overs format from the Duckworth-Lewis curve
+//     Z(u, w) = F(w) * (1 - exp(-b * u / F(w)))
+// with u in overs, rescaled so a full innings with all wickets in hand is
+// 10000. Rain-revised targets and par scores are a lookup each.
+namespace ResourceCurve {
+
+constexpr int Full = 10000;
+constexpr double Decay = 0.027; // b, per over
+
+// F(w): share of the asymptotic run total still available after w wickets
+constexpr double WicketShare[10] = {1.0, 0.883, 0.759, 0.629, 0.498, 0.372, 0.260, 0.163, 0.088, 0.035};
+
+// exp(x) for x <= 0: halve into the range where the series converges fast,
+// then square back up
+constexpr double Exp(double x) {
+    int halvings = 0;
+    while (x < -0.5) {
+        x *= 0.5;
+        ++halvings;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 16; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings-- > 0) {
+        sum *= sum;
+    }
+    return sum;
+}
+
+constexpr double Resources(double overs, int wickets) {
+    double share = WicketShare[wickets];
+    return share * (1.0 - Exp(-Decay * overs / share));
+}
+
+} // namespace ResourceCurve
+
+template <int MaxOvers>
+struct ResourceTable {
+    static constexpr int MaxBalls = MaxOvers * 6;
+
+    // [wickets lost][balls left]; ten wickets down leaves nothing
+    std::array<std::array<uint16_t, MaxBalls + 1>, 11> values{};
+
+    constexpr ResourceTable() {
+        double full = ResourceCurve::Resources(MaxOvers, 0);
+        for (int wickets = 0; wickets < 10; ++wickets) {
+            for (int balls = 0; balls <= MaxBalls; ++balls) {
+                double share = ResourceCurve::Resources(balls / 6.0, wickets) / full;
+                values[wickets][balls] = static_cast<uint16_t>(share * ResourceCurve::Full + 0.5);
+            }
+        }
+    }
+
+    constexpr int Get(int ballsLeft, int wicketsLost) const {
+        return values[wicketsLost][ballsLeft];
+    }
+};
+
+// One table per format, e.g. Resources<ODIPolicy>.Get(ballsLeft, wickets)
+template <typename Format>
+inline constexpr ResourceTable<Format::MaxOvers> Resources{};
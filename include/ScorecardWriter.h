@@ -0,0 +1,28 @@
+#pragma once
+
+#include "MatchEngine.h"
+#include <string>
+
+enum class ScorecardFormat {
+    TEXT,
+    JSON,
+    CSV
+};
+
+// Renders full batting and bowling cards, fall of wickets and the result of
+// a match straight from the engine's fixed-size stats. Output is appended to
+// a caller-owned string with std::to_chars number formatting; clear it and
+// reuse it between matches, and once it has grown to fit a scorecard
+// rendering more of them does not allocate.
+class ScorecardWriter {
+public:
+    static void Write(const MatchEngine& engine, ScorecardFormat format, std::string& out);
+
+    // "<team> won by 12 runs", "Match tied" and so on
+    static void WriteResult(const MatchEngine& engine, std::string& out);
+
+private:
+    static void WriteText(const MatchEngine& engine, std::string& out);
+    static void WriteJson(const MatchEngine& engine, std::string& out);
+    static void WriteCsv(const MatchEngine& engine, std::string& out);
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RandomStream.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -98,6 +99,8 @@ public:
     // Pitch conditions
     void UpdatePitchConditions(int daysSinceLastMatch);
     void PreparePitchForMatch();
+    void UpdatePitchWear(PitchCharacteristics& pitch) const; // one day's play on the pitch
+    static void CalculatePitchEffects(PitchCharacteristics& pitch); // spin, seam and bounce from the rest
     double GetPitchDifficulty() const;
     double GetBattingAdvantage() const;
     double GetBowlingAdvantage() const;
@@ -142,6 +145,7 @@ private:
     // Weather
     WeatherPattern currentWeather;
     std::vector<WeatherPattern> weatherForecast;
+    RandomStream weatherRandom; // keyed by venue name
     
     // Match history
     std::vector<std::string> matchHistory;
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MatchEngine.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// Background Monte Carlo estimator for the batting side's chance of winning.
+// The worker plays from its own copy of the fixture, so a request only carries
+// the live score state, which is fixed in size; results are cached by a
+// compact state key.
+// At most one request waits at a time: each new Submit drops the one before.
+class WinProbabilityEngine {
+public:
+    explicit WinProbabilityEngine(int simulationsPerState = 200);
+    ~WinProbabilityEngine();
+
+    // Innings, runs, wickets, balls remaining and target packed into one key
+    static uint64_t MakeStateKey(int innings, int runs, int wickets, int ballsRemaining, int target);
+
+    // Batting side's probability for a state already estimated
+    bool Lookup(uint64_t key, double& probability) const;
+
+    // Latest published estimate, as team1's chance of winning (-1 before any)
+    double GetLatestTeam1Probability() const;
+
+    // Queue a state for estimation, replacing any request not yet started.
+    // With lookahead, the states its likely next balls lead to follow it,
+    // until a newer request arrives.
+    void Submit(uint64_t key, const MatchEngine::ScoreState& state, TeamId battingTeam, bool lookahead);
+
+    // Forget cached states and estimate from a new copy of the fixture, e.g.
+    // after line-ups or conditions change. The copy needs no match state.
+    void Clear(std::unique_ptr<MatchEngine> configuration);
+
+private:
+    struct Request {
+        uint64_t key;
+        MatchEngine::ScoreState state;
+        TeamId battingTeam;
+        bool lookahead;
+    };
+
+    int simulationsPerState;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Request> pending;
+    std::unordered_map<uint64_t, double> cache;
+    std::unique_ptr<MatchEngine> nextConfiguration; // picked up by the worker
+    std::unique_ptr<MatchEngine> engine;            // worker thread only
+    uint64_t generation; // bumped by Clear so stale results are dropped
+    double latestTeam1Probability;
+    bool stopping;
+    std::thread worker;
+
+    void Run();
+    std::vector<Request> ExpandRequest(Request request);
+    double Estimate(const Request& request);
+};
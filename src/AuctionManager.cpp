@@ -1,14 +1,13 @@
 #include "AuctionManager.h"
 #include <iostream>
 #include <algorithm>
-#include <random>
 #include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 
 AuctionManager::AuctionManager() 
-    : randomGenerator(std::random_device{}())
+    : randomGenerator(RandomService::GetStream(RandomDomain::AUCTION))
     , aiBiddingEnabled(false)
     , biddingTimeSeconds(30)
     , remainingTimeSeconds(30)
@@ -24,8 +23,8 @@ AuctionManager::~AuctionManager() {
 }
 
 bool AuctionManager::initialize() {
-    // Initialize random number generator
-    randomGenerator.seed(std::chrono::steady_clock::now().time_since_epoch().count());
+    // Restart the auction stream so a seeded run replays the same auction
+    randomGenerator = RandomService::GetStream(RandomDomain::AUCTION);
     
     // Initialize auction session
     currentSession.sessionName = "Default Auction";
@@ -0,0 +1,23 @@
+#include "MatchEngine.h"
+
+void BallLog::Append(const BallRecord& ball) {
+    size_t chunkIndex = count / ChunkSize;
+    if (chunkIndex == chunks.size()) {
+        chunks.push_back(std::make_shared<Chunk>());
+    } else if (chunks[chunkIndex].use_count() > 1) {
+        // Another log still sees this chunk; copy before writing past its prefix
+        chunks[chunkIndex] = std::make_shared<Chunk>(*chunks[chunkIndex]);
+    }
+    (*chunks[chunkIndex])[count % ChunkSize] = ball;
+    count++;
+}
+
+void BallLog::Clear() {
+    // Keep the first chunk for reuse when nobody else shares it
+    if (!chunks.empty() && chunks.front().use_count() == 1) {
+        chunks.resize(1);
+    } else {
+        chunks.clear();
+    }
+    count = 0;
+}
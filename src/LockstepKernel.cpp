@@ -0,0 +1,117 @@
+#include "LockstepKernel.h"
+#include "LockstepLanes.h"
+#include "MatchEngine.h"
+
+static_assert(BallResultCount == lockstep::ResultCount, "lockstep masks cover every ball result");
+static_assert(static_cast<int>(BallResult::WIDE) == 7 && static_cast<int>(BallResult::NO_BALL) == 8 &&
+              static_cast<int>(BallResult::WICKET) == 6 && static_cast<int>(BallResult::RUN_OUT) == 11,
+              "lockstep masks assume the BallResult order");
+
+namespace {
+
+// One match at a time through the same lane loop
+struct ScalarOps {
+    using Vec = uint32_t;
+    using Mask = bool;
+    static constexpr int Width = 1;
+
+    static Vec Load(const uint32_t* p) { return *p; }
+    static void Store(uint32_t* p, Vec v) { *p = v; }
+    static Vec Set(uint32_t x) { return x; }
+
+    static Vec Add(Vec a, Vec b) { return a + b; }
+    static Vec And(Vec a, Vec b) { return a & b; }
+    static Vec Or(Vec a, Vec b) { return a | b; }
+    static Vec Xor(Vec a, Vec b) { return a ^ b; }
+    static Vec MulLo(Vec a, Vec b) { return a * b; }
+    static Vec MulHi(Vec a, Vec b) { return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32); }
+    static Vec ShiftRight(Vec a, Vec count) { return a >> count; }
+    template <int N>
+    static Vec ShiftLeft(Vec a) { return a << N; }
+    static Vec Gather(const uint32_t* base, Vec index) { return base[index]; }
+
+    static Mask NonZero(Vec a) { return a != 0; }
+    static Mask AtLeast(Vec a, Vec b) { return a >= b; }
+    static Mask Below(Vec a, Vec b) { return a < b; }
+    static Mask MaskAnd(Mask a, Mask b) { return a && b; }
+    static Mask MaskAndNot(Mask a, Mask b) { return !a && b; }
+    static Mask MaskOr(Mask a, Mask b) { return a || b; }
+    static Mask MaskXor(Mask a, Mask b) { return a != b; }
+    static Vec Select(Mask m, Vec ifTrue, Vec ifFalse) { return m ? ifTrue : ifFalse; }
+    static uint32_t Bits(Mask m) { return m ? 1u : 0u; }
+};
+
+bool CpuSupports(SimdLevel level) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    switch (level) {
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+        case SimdLevel::AVX2: return __builtin_cpu_supports("avx2");
+        default: return true;
+    }
+#else
+    return level == SimdLevel::SCALAR;
+#endif
+}
+
+bool BuildSupports(SimdLevel level) {
+    switch (level) {
+#ifdef LOCKSTEP_HAVE_AVX512
+        case SimdLevel::AVX512: return true;
+#endif
+#ifdef LOCKSTEP_HAVE_AVX2
+        case SimdLevel::AVX2: return true;
+#endif
+        case SimdLevel::SCALAR: return true;
+        default: return false;
+    }
+}
+
+} // namespace
+
+SimdLevel LockstepKernel::GetSupportedLevel() {
+    static const SimdLevel level = [] {
+        for (SimdLevel candidate : {SimdLevel::AVX512, SimdLevel::AVX2}) {
+            if (BuildSupports(candidate) && CpuSupports(candidate)) {
+                return candidate;
+            }
+        }
+        return SimdLevel::SCALAR;
+    }();
+    return level;
+}
+
+const char* LockstepKernel::GetLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AUTO: return GetLevelName(GetSupportedLevel());
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+    }
+    return "";
+}
+
+int LockstepKernel::GetLaneCount(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AUTO: return GetLaneCount(GetSupportedLevel());
+        case SimdLevel::AVX2: return 8;
+        case SimdLevel::AVX512: return 16;
+        default: return 1;
+    }
+}
+
+void LockstepKernel::Run(const LockstepJob& job, SimdLevel level) {
+    SimdLevel supported = GetSupportedLevel();
+    if (level == SimdLevel::AUTO || static_cast<int>(level) > static_cast<int>(supported)) {
+        level = supported;
+    }
+
+    switch (level) {
+#ifdef LOCKSTEP_HAVE_AVX512
+        case SimdLevel::AVX512: lockstep::RunAvx512(job); return;
+#endif
+#ifdef LOCKSTEP_HAVE_AVX2
+        case SimdLevel::AVX2: lockstep::RunAvx2(job); return;
+#endif
+        default: lockstep::RunLanes<ScalarOps>(job); return;
+    }
+}
@@ -0,0 +1,53 @@
+#include "LockstepLanes.h"
+#include <immintrin.h>
+
+// Built with -mavx2; only called once the CPU is known to support it
+
+namespace {
+
+struct Avx2Ops {
+    using Vec = __m256i;
+    using Mask = __m256i; // all-ones lanes
+    static constexpr int Width = 8;
+
+    static Vec Load(const uint32_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(uint32_t* p, Vec v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec Set(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+
+    static Vec Add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+    static Vec And(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    static Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static Vec Xor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+    static Vec MulLo(Vec a, Vec b) { return _mm256_mullo_epi32(a, b); }
+    static Vec MulHi(Vec a, Vec b) {
+        Vec even = _mm256_mul_epu32(a, b);
+        Vec odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+    static Vec ShiftRight(Vec a, Vec count) { return _mm256_srlv_epi32(a, count); }
+    template <int N>
+    static Vec ShiftLeft(Vec a) { return _mm256_slli_epi32(a, N); }
+    static Vec Gather(const uint32_t* base, Vec index) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), index, 4);
+    }
+
+    // Lane values stay far below 2^31, so signed compares are safe except in Below
+    static Mask NonZero(Vec a) { return _mm256_xor_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), Set(~0u)); }
+    static Mask AtLeast(Vec a, Vec b) { return _mm256_xor_si256(_mm256_cmpgt_epi32(b, a), Set(~0u)); }
+    static Mask Below(Vec a, Vec b) {
+        Vec sign = Set(0x80000000u);
+        return _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+    }
+    static Mask MaskAnd(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+    static Mask MaskAndNot(Mask a, Mask b) { return _mm256_andnot_si256(a, b); }
+    static Mask MaskOr(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+    static Mask MaskXor(Mask a, Mask b) { return _mm256_xor_si256(a, b); }
+    static Vec Select(Mask m, Vec ifTrue, Vec ifFalse) { return _mm256_blendv_epi8(ifFalse, ifTrue, m); }
+    static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+};
+
+} // namespace
+
+void lockstep::RunAvx2(const LockstepJob& job) {
+    RunLanes<Avx2Ops>(job);
+}
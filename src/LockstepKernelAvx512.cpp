@@ -0,0 +1,52 @@
+#include "LockstepLanes.h"
+#include <immintrin.h>
+
+// GCC 12 flags the deliberately undefined registers inside its own AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// Built with -mavx512f; only called once the CPU is known to support it
+
+namespace {
+
+struct Avx512Ops {
+    using Vec = __m512i;
+    using Mask = __mmask16;
+    static constexpr int Width = 16;
+
+    static Vec Load(const uint32_t* p) { return _mm512_load_si512(p); }
+    static void Store(uint32_t* p, Vec v) { _mm512_store_si512(p, v); }
+    static Vec Set(uint32_t x) { return _mm512_set1_epi32(static_cast<int>(x)); }
+
+    static Vec Add(Vec a, Vec b) { return _mm512_add_epi32(a, b); }
+    static Vec And(Vec a, Vec b) { return _mm512_and_si512(a, b); }
+    static Vec Or(Vec a, Vec b) { return _mm512_or_si512(a, b); }
+    static Vec Xor(Vec a, Vec b) { return _mm512_xor_si512(a, b); }
+    static Vec MulLo(Vec a, Vec b) { return _mm512_mullo_epi32(a, b); }
+    static Vec MulHi(Vec a, Vec b) {
+        Vec even = _mm512_mul_epu32(a, b);
+        Vec odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+        return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+    }
+    static Vec ShiftRight(Vec a, Vec count) { return _mm512_srlv_epi32(a, count); }
+    template <int N>
+    static Vec ShiftLeft(Vec a) { return _mm512_slli_epi32(a, N); }
+    static Vec Gather(const uint32_t* base, Vec index) { return _mm512_i32gather_epi32(index, base, 4); }
+
+    static Mask NonZero(Vec a) { return _mm512_test_epi32_mask(a, a); }
+    static Mask AtLeast(Vec a, Vec b) { return _mm512_cmpge_epu32_mask(a, b); }
+    static Mask Below(Vec a, Vec b) { return _mm512_cmplt_epu32_mask(a, b); }
+    static Mask MaskAnd(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+    static Mask MaskAndNot(Mask a, Mask b) { return static_cast<Mask>(~a & b); }
+    static Mask MaskOr(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+    static Mask MaskXor(Mask a, Mask b) { return static_cast<Mask>(a ^ b); }
+    static Vec Select(Mask m, Vec ifTrue, Vec ifFalse) { return _mm512_mask_blend_epi32(m, ifFalse, ifTrue); }
+    static uint32_t Bits(Mask m) { return m; }
+};
+
+} // namespace
+
+void lockstep::RunAvx512(const LockstepJob& job) {
+    RunLanes<Avx512Ops>(job);
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "LockstepKernel.h"
+#include <cstdint>
+
+// Lane loop shared by every instruction set. Each translation unit supplies an
+// Ops type for its vector width and instantiates RunLanes<Ops>; nothing here
+// may pull in library code, since those units are built with their own
+// instruction-set flags.
+
+namespace lockstep {
+
+constexpr uint32_t ResultCount = 12;
+
+// Per-result properties as bit masks indexed by BallResult
+constexpr uint32_t RunsBit0 = 1u << 1 | 1u << 3 | 1u << 7 | 1u << 8 | 1u << 9 | 1u << 10;
+constexpr uint32_t RunsBit1 = 1u << 2 | 1u << 3 | 1u << 5;
+constexpr uint32_t RunsBit2 = 1u << 4 | 1u << 5;
+constexpr uint32_t LegalMask = 0xFFFu & ~(1u << 7 | 1u << 8);
+constexpr uint32_t WicketMask = 1u << 6 | 1u << 11;
+
+// Philox4x32-10 multipliers and key increments, as in RandomStream
+constexpr uint32_t PhiloxM0 = 0xD2511F53u;
+constexpr uint32_t PhiloxM1 = 0xCD9E8D57u;
+constexpr uint32_t PhiloxW0 = 0x9E3779B9u;
+constexpr uint32_t PhiloxW1 = 0xBB67AE85u;
+
+void RunAvx2(const LockstepJob& job);
+void RunAvx512(const LockstepJob& job);
+
+template <class Ops>
+typename Ops::Vec PropertyBit(uint32_t mask, typename Ops::Vec result) {
+    return Ops::And(Ops::ShiftRight(Ops::Set(mask), result), Ops::Set(1));
+}
+
+// First word of the Philox block for counter {0, 0, low, high}, i.e. the
+// first draw RandomStream(seed, high << 32 | low) makes
+template <class Ops>
+typename Ops::Vec FirstDraw(const uint32_t (&roundKeys)[10][2], typename Ops::Vec low, typename Ops::Vec high) {
+    using Vec = typename Ops::Vec;
+    const Vec m0 = Ops::Set(PhiloxM0);
+    const Vec m1 = Ops::Set(PhiloxM1);
+    Vec x0 = Ops::Set(0);
+    Vec x1 = Ops::Set(0);
+    Vec x2 = low;
+    Vec x3 = high;
+    for (int round = 0; round < 10; ++round) {
+        Vec hi0 = Ops::MulHi(x0, m0);
+        Vec lo0 = Ops::MulLo(x0, m0);
+        Vec hi1 = Ops::MulHi(x2, m1);
+        Vec lo1 = Ops::MulLo(x2, m1);
+        x0 = Ops::Xor(Ops::Xor(hi1, x1), Ops::Set(roundKeys[round][0]));
+        x1 = lo1;
+        x2 = Ops::Xor(Ops::Xor(hi0, x3), Ops::Set(roundKeys[round][1]));
+        x3 = lo0;
+    }
+    return x0;
+}
+
+template <class Ops>
+void RunLanes(const LockstepJob& job) {
+    using Vec = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+    constexpr int Width = Ops::Width;
+
+    // Lane state, one array per field
+    alignas(64) uint32_t match[Width];
+    alignas(64) uint32_t innings[Width];
+    alignas(64) uint32_t delivery[Width];
+    alignas(64) uint32_t runs[Width];
+    alignas(64) uint32_t wickets[Width];
+    alignas(64) uint32_t ball[Width];
+    alignas(64) uint32_t over[Width];
+    alignas(64) uint32_t striker[Width];    // slots in the batting order
+    alignas(64) uint32_t nonStriker[Width];
+    alignas(64) uint32_t nextBatter[Width];
+    alignas(64) uint32_t bowler[Width];     // slot in the bowling order
+    alignas(64) uint32_t target[Width];     // 0 in the first innings
+    alignas(64) uint32_t tableBase[Width];
+    alignas(64) uint32_t bowlers[Width];
+    alignas(64) uint32_t wicketLimit[Width];
+    bool active[Width];
+
+    uint32_t roundKeys[10][2];
+    uint32_t k0 = static_cast<uint32_t>(job.seed);
+    uint32_t k1 = static_cast<uint32_t>(job.seed >> 32);
+    for (int round = 0; round < 10; ++round) {
+        roundKeys[round][0] = k0;
+        roundKeys[round][1] = k1;
+        k0 += PhiloxW0;
+        k1 += PhiloxW1;
+    }
+
+    auto startInnings = [&](int lane, uint32_t side) {
+        innings[lane] = side;
+        delivery[lane] = 0;
+        runs[lane] = 0;
+        wickets[lane] = 0;
+        ball[lane] = 0;
+        over[lane] = 0;
+        striker[lane] = 0;
+        nonStriker[lane] = 1;
+        nextBatter[lane] = 2;
+        bowler[lane] = 0;
+        tableBase[lane] = job.tableBase[side];
+        bowlers[lane] = job.bowlers[side];
+        wicketLimit[lane] = job.wicketLimit[side];
+    };
+
+    // Lanes without a match keep replaying a valid state with results ignored
+    uint32_t nextMatch = 0;
+    int activeLanes = 0;
+    auto loadMatch = [&](int lane) {
+        active[lane] = nextMatch < job.matchCount;
+        match[lane] = job.firstMatch + (active[lane] ? nextMatch++ : 0);
+        activeLanes += active[lane] ? 1 : 0;
+        target[lane] = 0;
+        startInnings(lane, 0);
+    };
+    for (int lane = 0; lane < Width; ++lane) {
+        loadMatch(lane);
+    }
+
+    const Vec zero = Ops::Set(0);
+    const Vec one = Ops::Set(1);
+    const Vec six = Ops::Set(6);
+    const Vec resultCount = Ops::Set(ResultCount);
+    const Vec maxOvers = Ops::Set(job.maxOvers);
+
+    while (activeLanes > 0) {
+        Vec vInnings = Ops::Load(innings);
+        Vec vDelivery = Ops::Load(delivery);
+        Vec vStriker = Ops::Load(striker);
+        Vec vNonStriker = Ops::Load(nonStriker);
+        Vec vBowler = Ops::Load(bowler);
+        Vec vBowlers = Ops::Load(bowlers);
+
+        // One draw picks a column of the batter-vs-bowler alias table
+        Vec draw = FirstDraw<Ops>(roundKeys, Ops::Or(Ops::template ShiftLeft<24>(vInnings), vDelivery),
+                                  Ops::Load(match));
+        Vec column = Ops::MulHi(draw, resultCount);
+        Vec fraction = Ops::MulLo(draw, resultCount);
+        Vec table = Ops::Add(Ops::Load(tableBase), Ops::Add(Ops::MulLo(vStriker, vBowlers), vBowler));
+        Vec index = Ops::Add(Ops::MulLo(table, resultCount), column);
+        Vec result = Ops::Select(Ops::Below(fraction, Ops::Gather(job.thresholds, index)),
+                                 column, Ops::Gather(job.aliases, index));
+
+        Vec ballRuns = Ops::Or(PropertyBit<Ops>(RunsBit0, result),
+                       Ops::Or(Ops::template ShiftLeft<1>(PropertyBit<Ops>(RunsBit1, result)),
+                               Ops::template ShiftLeft<2>(PropertyBit<Ops>(RunsBit2, result))));
+        Vec legal = PropertyBit<Ops>(LegalMask, result);
+        Vec out = PropertyBit<Ops>(WicketMask, result);
+        Mask isOut = Ops::NonZero(out);
+
+        Vec vRuns = Ops::Add(Ops::Load(runs), ballRuns);
+        Vec vWickets = Ops::Add(Ops::Load(wickets), out);
+        Vec vBall = Ops::Add(Ops::Load(ball), legal);
+        Vec vNextBatter = Ops::Load(nextBatter);
+        vDelivery = Ops::Add(vDelivery, one);
+
+        // The next batter replaces a dismissed striker; odd runs off a legal
+        // ball swap ends
+        vStriker = Ops::Select(isOut, vNextBatter, vStriker);
+        vNextBatter = Ops::Add(vNextBatter, out);
+        Mask swap = Ops::MaskAndNot(isOut, Ops::NonZero(Ops::And(legal, ballRuns)));
+
+        // End of the over: swap ends and bring on the next bowler
+        Mask overEnd = Ops::AtLeast(vBall, six);
+        swap = Ops::MaskXor(swap, overEnd);
+        Vec swappedStriker = Ops::Select(swap, vNonStriker, vStriker);
+        vNonStriker = Ops::Select(swap, vStriker, vNonStriker);
+        vStriker = swappedStriker;
+        vBall = Ops::Select(overEnd, zero, vBall);
+        Vec vOver = Ops::Add(Ops::Load(over), Ops::Select(overEnd, one, zero));
+        Vec nextBowler = Ops::Add(vBowler, one);
+        nextBowler = Ops::Select(Ops::AtLeast(nextBowler, vBowlers), zero, nextBowler);
+        vBowler = Ops::Select(overEnd, nextBowler, vBowler);
+
+        Vec vTarget = Ops::Load(target);
+        Mask ended = Ops::MaskOr(Ops::AtLeast(vWickets, Ops::Load(wicketLimit)),
+                     Ops::MaskOr(Ops::AtLeast(vOver, maxOvers),
+                                 Ops::MaskAnd(Ops::NonZero(vTarget), Ops::AtLeast(vRuns, vTarget))));
+
+        Ops::Store(delivery, vDelivery);
+        Ops::Store(runs, vRuns);
+        Ops::Store(wickets, vWickets);
+        Ops::Store(ball, vBall);
+        Ops::Store(over, vOver);
+        Ops::Store(striker, vStriker);
+        Ops::Store(nonStriker, vNonStriker);
+        Ops::Store(nextBatter, vNextBatter);
+        Ops::Store(bowler, vBowler);
+
+        // Innings changes are rare enough to handle one lane at a time
+        uint32_t endedLanes = Ops::Bits(ended);
+        for (int lane = 0; endedLanes != 0; ++lane, endedLanes >>= 1) {
+            if ((endedLanes & 1) == 0) {
+                continue;
+            }
+            if (innings[lane] == 0) {
+                if (active[lane]) {
+                    job.firstInningsRuns[match[lane] - job.firstMatch] = static_cast<uint16_t>(runs[lane]);
+                }
+                target[lane] = runs[lane] + 1;
+                startInnings(lane, 1);
+            } else {
+                if (active[lane]) {
+                    job.secondInningsRuns[match[lane] - job.firstMatch] = static_cast<uint16_t>(runs[lane]);
+                    activeLanes--;
+                }
+                loadMatch(lane);
+            }
+        }
+    }
+}
+
+} // namespace lockstep
@@ -1,311 +1,2300 @@
 #include "MatchEngine.h"
+#include "MatchReplay.h"
+#include "MatchEventBus.h"
+#include "ScorecardWriter.h"
+#include "ResourceTable.h"
+#include "WinProbability.h"
 #include <iostream>
-#include <sstream>
 #include <algorithm>
 #include <random>
+#include <thread>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Runs credited for each ball result
+int GetBallRuns(BallResult result) {
+    switch (result) {
+        case BallResult::SINGLE: return 1;
+        case BallResult::DOUBLE: return 2;
+        case BallResult::TRIPLE: return 3;
+        case BallResult::FOUR: return 4;
+        case BallResult::SIX: return 6;
+        case BallResult::WIDE: return 1;
+        case BallResult::NO_BALL: return 1;
+        case BallResult::BYE: return 1;
+        case BallResult::LEG_BYE: return 1;
+        default: return 0;
+    }
+}
+
+// Fixed one-line description for each ball result
+const char* GetBallCommentary(const BallRecord& ball) {
+    if (ball.GetResult() == BallResult::WICKET) {
+        switch (ball.GetWicketType()) {
+            case WicketType::CAUGHT: return "WICKET! Caught!";
+            case WicketType::LBW: return "WICKET! LBW!";
+            case WicketType::STUMPED: return "WICKET! Stumped!";
+            default: return "WICKET! Bowled!";
+        }
+    }
+    switch (ball.GetResult()) {
+        case BallResult::DOT_BALL: return "Dot ball!";
+        case BallResult::SINGLE: return "Single taken.";
+        case BallResult::DOUBLE: return "Two runs.";
+        case BallResult::TRIPLE: return "Three runs.";
+        case BallResult::FOUR: return "FOUR! Beautiful shot!";
+        case BallResult::SIX: return "SIX! Massive hit!";
+        case BallResult::WICKET: return "WICKET! Bowled!";
+        case BallResult::WIDE: return "Wide ball.";
+        case BallResult::NO_BALL: return "No ball.";
+        case BallResult::BYE: return "Byes.";
+        case BallResult::LEG_BYE: return "Leg byes.";
+        case BallResult::RUN_OUT: return "WICKET! Run out!";
+    }
+    return "";
+}
+
+} // namespace
 
 MatchEngine::MatchEngine() 
     : team1(nullptr)
     , team2(nullptr)
     , venue(nullptr)
     , matchType(MatchType::T20)
+    , superOverOnTie(false)
+    , names(std::make_shared<NameTable>())
+    , outcomeTablesDirty(true)
+    , battingSide(0)
+    , nextBatterIndex(0)
+    , bowlerIndex(0)
+    , target(0)
+    , isInningsComplete(false)
+    , currentInningsIndex(0)
+    , deliveryIndex(0)
+    , inningsTotals{}
+    , describedBalls(0)
+    , replayPrefixBalls(0)
+    , overRunsCharged(0)
+    , pitchConditions{5, 5, 5, 3, false, false, false}
+    , weatherConditions{25, 60, 10, "North", false, false, 10}
+    , pitchWear(0)
+    , pitchDrying(0)
+    , hasSkippedBalls(false)
+    , rainChance(0)
+    , rainDelayMinutes(0)
+    , rainDelayedStartMinutes(0)
+    , rainOversLost{}
+    , rainResourcesLost{}
+    , recordedRain(nullptr)
+    , fidelity(SimulationFidelity::FULL)
     , isPaused(false)
     , isMatchComplete(false)
+    , playbackMultiplier(1.0f)
+    , frameBudgetMs(4.0f)
+    , stepAccumulator(0.0)
+    , renderState{}
+    , randomSeed(RandomService::GetDomainKey(RandomDomain::MATCH))
+    , matchIndex(0)
 {
-    // Initialize random number generator
-    gen = std::mt19937(rd());
 }
 
 MatchEngine::~MatchEngine() {
 }
 
-void MatchEngine::InitializeMatch(Team* t1, Team* t2, Venue* v, MatchType type) {
-    team1 = t1;
-    team2 = t2;
-    venue = v;
-    matchType = type;
-    
-    // Initialize match state
-    matchState.matchType = type;
-    matchState.format = MatchFormat::FIRST_INNINGS;
-    matchState.currentInnings = 1;
-    matchState.currentOver = 0;
-    matchState.currentBall = 0;
-    matchState.isMatchComplete = false;
+void MatchEngine::InitializeMatch(Team* t1, Team* t2, Venue* v, MatchType type) {
+    team1 = t1;
+    team2 = t2;
+    venue = v;
+    matchType = type;
+    
+    // Resolve line-ups once so innings can be restarted cheaply
+    BuildLineups();
+    
+    // Until the caller numbers it, a match is keyed by its fixture alone, so
+    // nothing set up elsewhere in the process can change its streams
+    matchIndex = static_cast<uint32_t>(RandomService::Mix(GetLineupFingerprint(0) ^
+        RandomService::Mix(GetLineupFingerprint(1)) ^ GetVenueFingerprint()));
+    ResetWinProbability();
+    
+    ResetMatch();
+    PublishRenderState();
+    
+    if (fidelity == SimulationFidelity::FULL) {
+        std::cout << "Match initialized: " << team1->GetName() << " vs " << team2->GetName() 
+                  << " at " << venue->GetName() << std::endl;
+    }
+}
+
+void MatchEngine::SetRandomSeed(uint64_t seed) {
+    randomSeed = seed;
+}
+
+void MatchEngine::SetPitchConditions(const PitchConditions& conditions) {
+    pitchConditions = conditions;
+    outcomeTablesDirty = true;
+    ResetWinProbability();
+}
+
+void MatchEngine::SetWeatherConditions(const WeatherConditions& weather) {
+    weatherConditions = weather;
+    outcomeTablesDirty = true;
+    ResetWinProbability();
+}
+
+void MatchEngine::SetRainRisk(double chancePerOver, int meanDelayMinutes, int delayedStartMinutes) {
+    rainChance = static_cast<uint16_t>(std::max(0.0, std::min(chancePerOver, 1.0)) * 10000.0 + 0.5);
+    rainDelayMinutes = static_cast<uint8_t>(std::max(0, std::min(meanDelayMinutes, 255)));
+    rainDelayedStartMinutes = static_cast<uint8_t>(std::max(0, std::min(delayedStartMinutes, 255)));
+    
+    // Before the first ball, restart so the start of play is checked as well
+    if (team1 && team2 && currentInningsIndex == 0 && deliveryIndex == 0) {
+        ResetMatch();
+        PublishRenderState();
+    }
+}
+
+void MatchEngine::SetRainRiskFromVenue() {
+    if (!venue) {
+        return;
+    }
+    
+    // Showers are likelier once it is already raining, and an unplayable
+    // ground holds up the start by the venue's own estimate
+    const WeatherPattern& weather = venue->GetCurrentWeather();
+    double chance = weather.rainProbability * (weather.isRaining ? 0.1 : 0.02);
+    int delay = weather.isRaining ? std::max(30, venue->GetRainDelay()) : 30;
+    int delayedStart = venue->IsMatchPlayable() ? 0 : venue->GetRainDelay();
+    SetRainRisk(chance, delay, delayedStart);
+}
+
+int MatchEngine::GetAllottedOvers(int inningsIndex) const {
+    if (matchType == MatchType::TEST) {
+        return 0;
+    }
+    
+    // Until it starts, the chase stands to get what the first innings was given
+    if (inningsIndex == 1 && currentInningsIndex == 0) {
+        inningsIndex = 0;
+    }
+    return DispatchFormat(matchType, inningsIndex >= 2, [this, inningsIndex](auto format) {
+        return GetAllottedOversFor<decltype(format)>(inningsIndex);
+    });
+}
+
+int MatchEngine::GetParScore() const {
+    if (matchType == MatchType::TEST || currentInningsIndex != 1) {
+        return 0;
+    }
+    return WithInningsFormat([this](auto format) {
+        using Format = decltype(format);
+        if constexpr (Format::MinOversForResult > 0) {
+            // Par is the first innings scaled by the resources used so far
+            const InningsTotals& totals = inningsTotals[1];
+            int ballsLeft = std::max(0, GetAllottedOversFor<Format>(1) * 6 - totals.legalBalls);
+            int remaining = Resources<Format>.Get(ballsLeft, std::min(totals.wickets, 10));
+            return GetParFor<Format>(ResourceCurve::Full - rainResourcesLost[1] - remaining);
+        } else {
+            return 0;
+        }
+    });
+}
+
+template <typename Format>
+int MatchEngine::GetAllottedOversFor(int inningsIndex) const {
+    if constexpr (Format::MinOversForResult > 0) {
+        return Format::MaxOvers - rainOversLost[inningsIndex];
+    } else {
+        return Format::MaxOvers;
+    }
+}
+
+template <typename Format>
+int MatchEngine::GetParFor(int resourcesUsed) const {
+    // Scale the first innings down when the chase has used less than it had;
+    // beyond that, add the format's average score for the extra resources
+    int firstResources = ResourceCurve::Full - rainResourcesLost[0];
+    int firstRuns = inningsTotals[0].runs;
+    if (firstResources <= 0) {
+        return 0;
+    }
+    if (resourcesUsed <= firstResources) {
+        return firstRuns * resourcesUsed / firstResources;
+    }
+    return firstRuns + Format::AverageInningsScore * (resourcesUsed - firstResources) / ResourceCurve::Full;
+}
+
+template <typename Format>
+bool MatchEngine::IsNoResultFor() const {
+    // Rain left fewer than the minimum overs before the chase had faced them
+    if constexpr (Format::MinOversForResult > 0) {
+        return currentInningsIndex < 2 &&
+               GetAllottedOversFor<Format>(currentInningsIndex) < Format::MinOversForResult &&
+               inningsTotals[1].legalBalls < Format::MinOversForResult * 6;
+    } else {
+        return false;
+    }
+}
+
+template <typename Format>
+void MatchEngine::StartRainInningsFor() {
+    if constexpr (Format::MinOversForResult > 0) {
+        // The chase gets the overs the first innings was given, and any lost
+        // from those count as resources it never had
+        if (currentInningsIndex == 1) {
+            rainOversLost[1] = rainOversLost[0];
+            rainResourcesLost[1] = static_cast<uint16_t>(
+                ResourceCurve::Full - Resources<Format>.Get(GetAllottedOversFor<Format>(1) * 6, 0));
+            target = GetParFor<Format>(ResourceCurve::Full - rainResourcesLost[1]) + 1;
+        }
+        CheckForRainFor<Format>();
+    }
+}
+
+template <typename Format>
+void MatchEngine::CheckForRainFor() {
+    if constexpr (Format::MinOversForResult > 0) {
+        if (isInningsComplete || isMatchComplete) {
+            return;
+        }
+        if (recordedRain) {
+            ApplyRecordedRainFor<Format>();
+            return;
+        }
+        if (!IsRainEnabled()) {
+            return;
+        }
+        
+        // Each over's weather has a stream of its own, clear of the delivery
+        // and session streams, so forks see the same rain
+        int minutes = currentInningsIndex == 0 && matchState.currentOver == 0 ? rainDelayedStartMinutes : 0;
+        uint64_t streamId = static_cast<uint64_t>(matchIndex) << 32 |
+                            static_cast<uint64_t>(0xC0 | currentInningsIndex) << 24 |
+                            static_cast<uint64_t>(matchState.currentOver);
+        RandomStream stream(randomSeed, streamId);
+        if (rainChance > 0 && stream.NextInt(0, 9999) < rainChance) {
+            minutes += 1 + static_cast<int>(-std::log(1.0 - stream.NextDouble()) * rainDelayMinutes);
+        }
+        
+        // While the first side bats, the time lost is shared by both innings
+        int oversLost = minutes / (RainMinutesPerOver * (currentInningsIndex == 0 ? 2 : 1));
+        if (oversLost == 0) {
+            return;
+        }
+        
+        // Resources lost are those between the old and the new close of the innings
+        const InningsTotals& totals = inningsTotals[currentInningsIndex];
+        int allotted = GetAllottedOversFor<Format>(currentInningsIndex);
+        int reduced = std::max(matchState.currentOver, allotted - oversLost);
+        int wickets = std::min(totals.wickets, 10);
+        int lost = Resources<Format>.Get(allotted * 6 - totals.legalBalls, wickets) -
+                   Resources<Format>.Get(reduced * 6 - totals.legalBalls, wickets);
+        rainOversLost[currentInningsIndex] = static_cast<uint8_t>(Format::MaxOvers - reduced);
+        rainResourcesLost[currentInningsIndex] = static_cast<uint16_t>(rainResourcesLost[currentInningsIndex] + lost);
+        if (currentInningsIndex == 1) {
+            target = GetParFor<Format>(ResourceCurve::Full - rainResourcesLost[1]) + 1;
+        }
+        rainInterruptions.push_back(RainInterruption{
+            static_cast<uint16_t>(matchState.currentOver),
+            static_cast<uint8_t>(currentInningsIndex),
+            rainOversLost[currentInningsIndex],
+            rainResourcesLost[currentInningsIndex],
+            static_cast<uint16_t>(currentInningsIndex == 1 ? target : 0)
+        });
+        CheckInningsEndFor<Format>();
+    }
+}
+
+template <typename Format>
+void MatchEngine::ApplyRecordedRainFor() {
+    // At most one stoppage per innings and over, in the order they happened
+    for (const RainInterruption& rain : *recordedRain) {
+        if (rain.innings != currentInningsIndex || rain.over != matchState.currentOver) {
+            continue;
+        }
+        rainOversLost[currentInningsIndex] = rain.oversLost;
+        rainResourcesLost[currentInningsIndex] = rain.resourcesLost;
+        if (currentInningsIndex == 1) {
+            target = rain.target;
+        }
+        rainInterruptions.push_back(rain);
+        CheckInningsEndFor<Format>();
+        return;
+    }
+}
+
+void MatchEngine::SimulateBall() {
+    WithInningsFormat([this](auto format) { SimulateBallFor<decltype(format)>(); });
+}
+
+template <typename Format>
+void MatchEngine::SimulateBallFor() {
+    if (isPaused || isMatchComplete || isInningsComplete) {
+        return;
+    }
+    
+    // A side without a batter or bowler cannot continue
+    if (matchState.striker == NoPlayer || matchState.bowler == NoPlayer) {
+        EndInnings();
+        return;
+    }
+    
+    // Generate ball record
+    BallRecord ball = SimulateBallResult();
+    
+    // Update match state
+    UpdateMatchStateFor<Format>(ball);
+    
+    // Totals are all the fast path needs
+    if (fidelity == SimulationFidelity::SCORE_ONLY) {
+        return;
+    }
+    
+    // Add to ball history; commentary is derived from it on demand
+    ballHistory.Append(ball);
+    
+    // Notify listeners; names are only resolved for the synchronous callback
+    if (ballEventCallback || eventBus) {
+        double probability = -1.0;
+        bool isCurrent = false;
+        EstimateWinProbability(probability, isCurrent);
+        if (eventBus) {
+            PublishEvent(MatchEventType::BALL, &ball, probability, isCurrent);
+        }
+        if (ballEventCallback) {
+            BallEvent event = ResolveBallEvent(ball);
+            event.winProbability = probability;
+            event.winProbabilityIsCurrent = isCurrent;
+            ballEventCallback(event);
+        }
+    }
+    
+    // Update player stats and partnerships
+    UpdatePlayerStats(ball);
+    UpdateInningsProgress(ball, isInningsComplete ? NoPlayer : matchState.striker, matchState.nonStriker);
+}
+
+void MatchEngine::SimulateOver() {
+    WithInningsFormat([this](auto format) {
+        int over = matchState.currentOver;
+        while (matchState.currentOver == over && !isInningsComplete && !isMatchComplete && !isPaused) {
+            SimulateBallFor<decltype(format)>();
+        }
+    });
+}
+
+void MatchEngine::SimulateInnings() {
+    WithInningsFormat([this](auto format) { SimulateInningsFor<decltype(format)>(); });
+}
+
+template <typename Format>
+void MatchEngine::SimulateInningsFor() {
+    while (!isInningsComplete && !isMatchComplete && !isPaused) {
+        SimulateBallFor<Format>();
+    }
+}
+
+void MatchEngine::SimulateMatch() {
+    DispatchFormat(matchType, false, [this](auto format) { SimulateMatchFor<decltype(format)>(); });
+}
+
+template <typename Format>
+void MatchEngine::SimulateMatchFor() {
+    // Resumed or forked matches may start in any innings
+    while (!isMatchComplete && !isPaused) {
+        if (isInningsComplete) {
+            AdvanceInnings();
+        } else if (!Format::IsTimed && IsSuperOverInnings()) {
+            SimulateInningsFor<SuperOverPolicy>();
+        } else {
+            SimulateInningsFor<Format>();
+        }
+    }
+}
+
+void MatchEngine::SimulateSession() {
+    if (matchType != MatchType::TEST) {
+        if (isInningsComplete && !isMatchComplete) {
+            AdvanceInnings();
+        }
+        SimulateInnings();
+        return;
+    }
+    
+    int sessionEnd = (GetMatchBallsBowled() / TestPolicy::SessionBalls + 1) * TestPolicy::SessionBalls;
+    while (!isMatchComplete && !isPaused && GetMatchBallsBowled() < sessionEnd) {
+        if (isInningsComplete) {
+            AdvanceInnings();
+        } else {
+            SimulateBallFor<TestPolicy>();
+        }
+    }
+}
+
+void MatchEngine::FastForwardSession() {
+    if (matchType != MatchType::TEST) {
+        SimulateSession();
+        return;
+    }
+    
+    int session = GetMatchBallsBowled() / TestPolicy::SessionBalls;
+    int sessionEnd = (session + 1) * TestPolicy::SessionBalls;
+    
+    // One stream per session, clear of the per-delivery streams
+    uint64_t streamId = static_cast<uint64_t>(matchIndex) << 32 |
+                        static_cast<uint64_t>(0x80 | session) << 24;
+    RandomStream stream(randomSeed, streamId);
+    std::vector<SkipRates> rates;
+    int ratesSide = -1;
+    int ratesWear = -1;
+    int ratesDrying = -1;
+    while (!isMatchComplete && !isPaused && GetMatchBallsBowled() < sessionEnd) {
+        if (isInningsComplete) {
+            AdvanceInnings();
+            continue;
+        }
+        
+        // Batters' rates hold until the attack or the pitch changes
+        if (ratesSide != battingSide || ratesWear != pitchWear || ratesDrying != pitchDrying) {
+            rates.assign(players.size(), SkipRates{});
+            ratesSide = battingSide;
+            ratesWear = pitchWear;
+            ratesDrying = pitchDrying;
+        }
+        SkipStretch(sessionEnd - GetMatchBallsBowled(), stream, rates);
+    }
+}
+
+const MatchEngine::SkipRates& MatchEngine::GetSkipRates(PlayerId batter, std::vector<SkipRates>& rates) {
+    SkipRates& batterRates = rates[batter];
+    if (batterRates.deliveries > 0.0) {
+        return batterRates;
+    }
+    
+    // Bowlers rotate every over, so each bowls an equal share
+    const auto& attack = lineups[1 - battingSide].bowling;
+    std::array<double, BallResultCount> probability{};
+    for (PlayerId bowler : attack) {
+        auto weights = CalculateOutcomeWeights(players[batter], players[bowler]);
+        double total = 0.0;
+        for (double weight : weights) {
+            total += weight;
+        }
+        for (int i = 0; i < BallResultCount; ++i) {
+            probability[i] += total > 0.0 ? weights[i] / total / attack.size() : 0.0;
+        }
+    }
+    
+    double meanSquare = 0.0;
+    for (int i = 0; i < BallResultCount; ++i) {
+        BallRecord record{};
+        record.result = static_cast<uint8_t>(i);
+        int runs = GetBallRuns(record.GetResult());
+        batterRates.runs += probability[i] * runs;
+        meanSquare += probability[i] * runs * runs;
+        if (record.IsExtra()) {
+            batterRates.extraRuns += probability[i] * runs;
+        }
+        if (record.IsWicket()) {
+            batterRates.wicket += probability[i];
+        }
+    }
+    batterRates.runsVariance = meanSquare - batterRates.runs * batterRates.runs;
+    
+    // Everything per legal ball
+    double legal = std::max(0.1, 1.0 - probability[static_cast<int>(BallResult::WIDE)] -
+                                 probability[static_cast<int>(BallResult::NO_BALL)]);
+    batterRates.wicket /= legal;
+    batterRates.runs /= legal;
+    batterRates.runsVariance /= legal;
+    batterRates.extraRuns /= legal;
+    batterRates.deliveries = 1.0 / legal;
+    return batterRates;
+}
+
+void MatchEngine::SkipStretch(int ballsLeft, RandomStream& stream, std::vector<SkipRates>& rates) {
+    if (matchState.striker == NoPlayer || matchState.nonStriker == NoPlayer || matchState.bowler == NoPlayer) {
+        EndInnings();
+        return;
+    }
+    
+    const auto& attack = lineups[1 - battingSide].bowling;
+    const SkipRates& striker = GetSkipRates(matchState.striker, rates);
+    const SkipRates& nonStriker = GetSkipRates(matchState.nonStriker, rates);
+    
+    // Strike rotates, so the pair shares each ball
+    double wicket = std::max(1e-4, std::min(0.9, (striker.wicket + nonStriker.wicket) / 2.0));
+    double runs = (striker.runs + nonStriker.runs) / 2.0;
+    double variance = (striker.runsVariance + nonStriker.runsVariance) / 2.0;
+    double extraShare = runs > 0.0 ? (striker.extraRuns + nonStriker.extraRuns) / 2.0 / runs : 0.0;
+    
+    // Balls until the next wicket are geometric; end stretches on an over
+    // boundary at most six overs on, so declarations are still checked
+    int untilWicket = 1 + static_cast<int>(std::log(1.0 - stream.NextDouble()) / std::log(1.0 - wicket));
+    int balls = std::min(ballsLeft, 36 - matchState.currentBall);
+    bool wicketFalls = untilWicket <= balls;
+    balls = std::min(balls, untilWicket);
+    
+    // Runs over the stretch are close to normal
+    double u1 = std::max(stream.NextDouble(), 1e-12);
+    double u2 = stream.NextDouble();
+    double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    int stretchRuns = std::max(0, static_cast<int>(std::lround(runs * balls + z * std::sqrt(variance * balls))));
+    
+    InningsTotals& totals = inningsTotals[currentInningsIndex];
+    if (target > 0 && totals.runs + stretchRuns >= target) {
+        // The chase finishes before the stretch would have
+        int needed = target - totals.runs;
+        balls = std::max(1, std::min(balls, static_cast<int>(std::ceil(needed / std::max(runs, 0.1)))));
+        stretchRuns = needed;
+        wicketFalls = false;
+    }
+    
+    int extras = static_cast<int>(std::lround(stretchRuns * extraShare));
+    totals.runs += stretchRuns;
+    totals.extras += extras;
+    totals.legalBalls += balls;
+    
+    // The pair shares the strike and splits the runs by scoring rate
+    InningsProgress& progress = inningsProgress[currentInningsIndex];
+    if (progress.HasCurrentPartnership()) {
+        Partnership& partnership = progress.partnerships[progress.partnershipCount - 1];
+        int batterRuns = stretchRuns - extras;
+        double share = striker.runs + nonStriker.runs > 0.0 ? striker.runs / (striker.runs + nonStriker.runs) : 0.5;
+        int strikerRuns = static_cast<int>(std::lround(batterRuns * share));
+        partnership.runs += stretchRuns;
+        partnership.legalBalls += balls;
+        CreditPartnership(partnership, matchState.striker, strikerRuns, (balls + 1) / 2);
+        CreditPartnership(partnership, matchState.nonStriker, batterRuns - strikerRuns, balls / 2);
+    }
+    deliveryIndex += static_cast<int>(std::lround(balls * (striker.deliveries + nonStriker.deliveries) / 2.0));
+    
+    // Overs completed in the stretch each bring the next bowler
+    int ballInOver = matchState.currentBall + balls;
+    int overs = ballInOver / 6;
+    matchState.currentOver += overs;
+    matchState.currentBall = ballInOver % 6;
+    if (!attack.empty() && overs > 0) {
+        bowlerIndex = static_cast<int>((bowlerIndex + overs) % attack.size());
+        matchState.bowler = attack[bowlerIndex];
+    }
+    
+    // A stretch ending mid-over may have scored in that over
+    overRunsCharged = matchState.currentBall > 0 ? stretchRuns : 0;
+    if ((stretchRuns + overs) % 2 == 1) {
+        SwitchStriker();
+    }
+    
+    if (wicketFalls) {
+        // Either batter may be the one out, in proportion to their rates
+        if (stream.NextDouble() * (striker.wicket + nonStriker.wicket) >= striker.wicket) {
+            SwitchStriker();
+        }
+        totals.wickets++;
+        if (progress.HasCurrentPartnership()) {
+            RecordFallOfWicket(progress, matchState.striker, totals.legalBalls);
+        }
+        HandleWicket();
+    }
+    
+    hasSkippedBalls = true;
+    if (GetMatchBallsBowled() % TestPolicy::DayBalls == 0) {
+        ApplyPitchEffects();
+    }
+    CheckInningsEndFor<TestPolicy>();
+    
+    if (wicketFalls && !isInningsComplete && progress.wicketCount < InningsProgress::MaxWickets &&
+        matchState.striker != NoPlayer && matchState.nonStriker != NoPlayer) {
+        OpenPartnership(progress, matchState.striker, matchState.nonStriker);
+    }
+}
+
+int MatchEngine::GetDay() const {
+    int balls = std::min(GetMatchBallsBowled(), TestPolicy::MatchBalls - 1);
+    return balls / TestPolicy::DayBalls + 1;
+}
+
+int MatchEngine::GetSession() const {
+    int balls = std::min(GetMatchBallsBowled(), TestPolicy::MatchBalls - 1);
+    return balls / TestPolicy::SessionBalls % TestPolicy::SessionsPerDay + 1;
+}
+
+void MatchEngine::AdvanceInnings() {
+    if (IsResultDecided()) {
+        DetermineMatchResult();
+    } else {
+        StartInnings(GetNextBattingSide());
+    }
+}
+
+bool MatchEngine::IsResultDecided() const {
+    if (matchType == MatchType::TEST) {
+        if (currentInningsIndex + 1 >= TestPolicy::MaxInnings || GetMatchBallsBowled() >= TestPolicy::MatchBalls) {
+            return true;
+        }
+        
+        // Batting twice and still behind: beaten by an innings
+        return currentInningsIndex == 2 && GetTeamRuns(battingSide) < GetTeamRuns(1 - battingSide);
+    }
+    
+    // A tie after the main innings goes to a super over when enabled. Rain
+    // may have revised the target, or washed the match out before then.
+    if (currentInningsIndex < 2 && WithInningsFormat([this](auto format) { return IsNoResultFor<decltype(format)>(); })) {
+        return true;
+    }
+    if (currentInningsIndex == 1) {
+        return !superOverOnTie || inningsTotals[1].runs != target - 1;
+    }
+    return currentInningsIndex >= 3;
+}
+
+int MatchEngine::GetNextBattingSide() const {
+    if (matchType == MatchType::TEST) {
+        // A big enough first-innings lead sends the other side straight back in
+        if (currentInningsIndex == 1 && inningsTotals[0].runs - inningsTotals[1].runs >= TestPolicy::FollowOnMargin) {
+            return battingSide;
+        }
+    } else if (currentInningsIndex == 1) {
+        // The side that batted second bats first in the super over
+        return battingSide;
+    }
+    return 1 - battingSide;
+}
+
+MatchFormat MatchEngine::GetInningsFormat() const {
+    if (IsSuperOverInnings()) {
+        return MatchFormat::SUPER_OVER;
+    }
+    return currentInningsIndex == 0 ? MatchFormat::FIRST_INNINGS : MatchFormat::SECOND_INNINGS;
+}
+
+int MatchEngine::GetTeamRuns(int side) const {
+    // Super overs settle a tie; they do not add to the match totals
+    int last = matchType == MatchType::TEST ? currentInningsIndex : std::min(currentInningsIndex, 1);
+    int runs = 0;
+    for (int i = 0; i <= last; ++i) {
+        if (inningsTotals[i].battingSide == side) {
+            runs += inningsTotals[i].runs;
+        }
+    }
+    return runs;
+}
+
+int MatchEngine::GetMatchBallsBowled() const {
+    int balls = 0;
+    for (int i = 0; i <= currentInningsIndex; ++i) {
+        balls += inningsTotals[i].legalBalls;
+    }
+    return balls;
+}
+
+bool MatchEngine::ShouldDeclare() const {
+    if (matchType != MatchType::TEST || currentInningsIndex >= 3) {
+        return false;
+    }
+    
+    // First innings: bat on until the total is out of reach
+    if (currentInningsIndex < 2) {
+        return inningsTotals[currentInningsIndex].runs >= 600;
+    }
+    
+    // Third innings: set a target that needs more than three an over, but
+    // leave time to bowl the other side out
+    int lead = GetTeamRuns(battingSide) - GetTeamRuns(1 - battingSide);
+    int oversLeft = (TestPolicy::MatchBalls - GetMatchBallsBowled()) / 6;
+    return lead >= 200 && (lead >= 450 || lead >= oversLeft * 3);
+}
+
+BatchSimulationResult MatchEngine::SimulateBatch(int numSimulations, unsigned int numThreads) const {
+    BatchSimulationResult result{};
+    if (!team1 || !team2 || numSimulations <= 0) {
+        return result;
+    }
+    
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::min<unsigned int>(numThreads, numSimulations);
+    
+    // Per-worker accumulators, merged once all workers finish
+    struct PlayerTotals {
+        long long runs = 0;
+        long long ballsFaced = 0;
+        long long wickets = 0;
+    };
+    struct WorkerTotals {
+        int team1Wins = 0;
+        int team2Wins = 0;
+        int ties = 0;
+        int draws = 0;
+        int noResults = 0;
+        long long team1Runs = 0;
+        long long team2Runs = 0;
+        std::vector<int> team1Scores;
+        std::vector<int> team2Scores;
+        std::vector<PlayerTotals> players; // indexed by PlayerId
+    };
+    
+    std::vector<WorkerTotals> totals(numThreads);
+    
+    // Simulation i always uses match index i under a key derived from this
+    // match, so the split across workers cannot change any result
+    uint64_t batchSeed = GetBatchSeed();
+    
+    auto worker = [&](unsigned int workerIndex) {
+        WorkerTotals& local = totals[workerIndex];
+        int begin = static_cast<int>(static_cast<long long>(numSimulations) * workerIndex / numThreads);
+        int end = static_cast<int>(static_cast<long long>(numSimulations) * (workerIndex + 1) / numThreads);
+        
+        // Each worker owns an independent engine with its own state and generator
+        MatchEngine engine;
+        CopyConfigurationTo(engine);
+        engine.randomSeed = batchSeed;
+        local.players.resize(names->Size());
+        
+        auto addScore = [](std::vector<int>& distribution, int runs) {
+            if (runs >= static_cast<int>(distribution.size())) {
+                distribution.resize(runs + 1, 0);
+            }
+            distribution[runs]++;
+        };
+        
+        for (int sim = begin; sim < end; ++sim) {
+            engine.matchIndex = static_cast<uint32_t>(sim);
+            engine.ResetMatch();
+            engine.SimulateMatch();
+            
+            int team1Runs = engine.GetTeamRuns(0);
+            int team2Runs = engine.GetTeamRuns(1);
+            if (engine.matchState.winner == 0) local.team1Wins++;
+            else if (engine.matchState.winner == 1) local.team2Wins++;
+            else if (engine.matchState.isDraw) local.draws++;
+            else if (engine.matchState.isNoResult) local.noResults++;
+            else local.ties++;
+            local.team1Runs += team1Runs;
+            local.team2Runs += team2Runs;
+            addScore(local.team1Scores, team1Runs);
+            addScore(local.team2Scores, team2Runs);
+            
+            // The engine kept every player's line as it went
+            const auto& lines = engine.playerStats;
+            for (size_t i = 0; i < lines.size(); ++i) {
+                PlayerTotals& player = local.players[i % engine.players.size()];
+                player.runs += lines[i].runs;
+                player.ballsFaced += lines[i].ballsFaced;
+                player.wickets += lines[i].wickets;
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    // Merge worker results
+    long long team1Runs = 0, team2Runs = 0;
+    std::vector<PlayerTotals> playerTotals(names->Size());
+    for (const auto& local : totals) {
+        result.team1Wins += local.team1Wins;
+        result.team2Wins += local.team2Wins;
+        result.ties += local.ties;
+        result.draws += local.draws;
+        result.noResults += local.noResults;
+        team1Runs += local.team1Runs;
+        team2Runs += local.team2Runs;
+        
+        auto mergeScores = [](std::vector<int>& into, const std::vector<int>& from) {
+            if (from.size() > into.size()) {
+                into.resize(from.size(), 0);
+            }
+            for (size_t i = 0; i < from.size(); ++i) {
+                into[i] += from[i];
+            }
+        };
+        mergeScores(result.team1ScoreDistribution, local.team1Scores);
+        mergeScores(result.team2ScoreDistribution, local.team2Scores);
+        
+        for (size_t id = 0; id < local.players.size(); ++id) {
+            playerTotals[id].runs += local.players[id].runs;
+            playerTotals[id].ballsFaced += local.players[id].ballsFaced;
+            playerTotals[id].wickets += local.players[id].wickets;
+        }
+    }
+    
+    double n = static_cast<double>(numSimulations);
+    result.simulations = numSimulations;
+    result.team1WinPercentage = result.team1Wins * 100.0 / n;
+    result.team2WinPercentage = result.team2Wins * 100.0 / n;
+    result.tiePercentage = result.ties * 100.0 / n;
+    result.drawPercentage = result.draws * 100.0 / n;
+    result.team1AverageScore = team1Runs / n;
+    result.team2AverageScore = team2Runs / n;
+    
+    for (int side = 0; side < 2; ++side) {
+        for (PlayerId id : lineups[side].batting) {
+            const PlayerTotals& player = playerTotals[id];
+            result.playerExpectations[names->GetName(id)] = PlayerExpectation{
+                GetTeamName(static_cast<TeamId>(side)),
+                player.runs / n,
+                player.ballsFaced / n,
+                player.wickets / n
+            };
+        }
+    }
+    
+    return result;
+}
+
+BatchSimulationResult MatchEngine::SimulateLockstepBatch(int numSimulations, unsigned int numThreads,
+                                                        SimdLevel level) const {
+    // The kernel plays exactly two full limited-overs innings
+    bool limitedOvers = matchType != MatchType::TEST && !superOverOnTie && !IsRainEnabled();
+    bool lineupsComplete = lineups[0].batting.size() >= 2 && lineups[1].batting.size() >= 2 &&
+                           !lineups[0].bowling.empty() && !lineups[1].bowling.empty();
+    if (!team1 || !team2 || numSimulations <= 0 || !limitedOvers || !lineupsComplete) {
+        return SimulateBatch(numSimulations, numThreads);
+    }
+    
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::min<unsigned int>(numThreads, numSimulations);
+    
+    std::shared_ptr<const std::vector<OutcomeTable>> tables = outcomeTables;
+    if (outcomeTablesDirty || !tables) {
+        std::unique_ptr<MatchEngine> fork = Fork();
+        fork->BuildOutcomeTables();
+        tables = fork->outcomeTables;
+    }
+    
+    // Flatten each side's batter-vs-bowler tables in batting-order slots
+    std::vector<uint32_t> thresholds;
+    std::vector<uint32_t> aliases;
+    LockstepJob job{};
+    for (int side = 0; side < 2; ++side) {
+        const auto& batters = lineups[side].batting;
+        const auto& bowlers = lineups[1 - side].bowling;
+        job.tableBase[side] = static_cast<uint32_t>(thresholds.size() / BallResultCount);
+        job.bowlers[side] = static_cast<uint32_t>(bowlers.size());
+        job.wicketLimit[side] = static_cast<uint32_t>(std::min<size_t>(10, batters.size() - 1));
+        for (PlayerId batter : batters) {
+            for (PlayerId bowler : bowlers) {
+                const OutcomeTable& table = (*tables)[batter * players.size() + bowler];
+                thresholds.insert(thresholds.end(), table.threshold.begin(), table.threshold.end());
+                aliases.insert(aliases.end(), table.alias.begin(), table.alias.end());
+            }
+        }
+    }
+    job.thresholds = thresholds.data();
+    job.aliases = aliases.data();
+    job.maxOvers = DispatchFormat(matchType, false, [](auto format) { return decltype(format)::MaxOvers; });
+    job.seed = GetBatchSeed();
+    
+    struct WorkerTotals {
+        int team1Wins = 0;
+        int team2Wins = 0;
+        int ties = 0;
+        long long team1Runs = 0;
+        long long team2Runs = 0;
+        std::vector<int> team1Scores;
+        std::vector<int> team2Scores;
+    };
+    std::vector<WorkerTotals> totals(numThreads);
+    
+    auto worker = [&](unsigned int workerIndex) {
+        WorkerTotals& local = totals[workerIndex];
+        uint32_t begin = static_cast<uint32_t>(static_cast<long long>(numSimulations) * workerIndex / numThreads);
+        uint32_t end = static_cast<uint32_t>(static_cast<long long>(numSimulations) * (workerIndex + 1) / numThreads);
+        
+        // Kernel results land in small buffers that are folded in per chunk
+        const uint32_t chunkSize = 4096;
+        std::vector<uint16_t> firstRuns(chunkSize);
+        std::vector<uint16_t> secondRuns(chunkSize);
+        auto addScore = [](std::vector<int>& distribution, int runs) {
+            if (runs >= static_cast<int>(distribution.size())) {
+                distribution.resize(runs + 1, 0);
+            }
+            distribution[runs]++;
+        };
+        
+        for (uint32_t first = begin; first < end; first += chunkSize) {
+            LockstepJob chunk = job;
+            chunk.firstMatch = first;
+            chunk.matchCount = std::min(chunkSize, end - first);
+            chunk.firstInningsRuns = firstRuns.data();
+            chunk.secondInningsRuns = secondRuns.data();
+            LockstepKernel::Run(chunk, level);
+            
+            for (uint32_t i = 0; i < chunk.matchCount; ++i) {
+                int team1Runs = firstRuns[i];
+                int team2Runs = secondRuns[i];
+                // Tests never reach the kernel, so there are no draws here
+                if (team1Runs > team2Runs) local.team1Wins++;
+                else if (team2Runs > team1Runs) local.team2Wins++;
+                else local.ties++;
+                local.team1Runs += team1Runs;
+                local.team2Runs += team2Runs;
+                addScore(local.team1Scores, team1Runs);
+                addScore(local.team2Scores, team2Runs);
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    BatchSimulationResult result{};
+    long long team1Runs = 0, team2Runs = 0;
+    auto mergeScores = [](std::vector<int>& into, const std::vector<int>& from) {
+        if (from.size() > into.size()) {
+            into.resize(from.size(), 0);
+        }
+        for (size_t i = 0; i < from.size(); ++i) {
+            into[i] += from[i];
+        }
+    };
+    for (const auto& local : totals) {
+        result.team1Wins += local.team1Wins;
+        result.team2Wins += local.team2Wins;
+        result.ties += local.ties;
+        team1Runs += local.team1Runs;
+        team2Runs += local.team2Runs;
+        mergeScores(result.team1ScoreDistribution, local.team1Scores);
+        mergeScores(result.team2ScoreDistribution, local.team2Scores);
+    }
+    
+    double n = static_cast<double>(numSimulations);
+    result.simulations = numSimulations;
+    result.team1WinPercentage = result.team1Wins * 100.0 / n;
+    result.team2WinPercentage = result.team2Wins * 100.0 / n;
+    result.tiePercentage = result.ties * 100.0 / n;
+    result.team1AverageScore = team1Runs / n;
+    result.team2AverageScore = team2Runs / n;
+    return result;
+}
+
+uint64_t MatchEngine::GetBatchSeed() const {
+    return RandomService::Mix(randomSeed ^ 
+        (static_cast<uint64_t>(matchIndex) << 32 | static_cast<uint64_t>(RandomDomain::BATCH)));
+}
+
+int MatchEngine::GetCurrentScore() const {
+    return inningsTotals[currentInningsIndex].runs;
+}
+
+int MatchEngine::GetCurrentWickets() const {
+    return inningsTotals[currentInningsIndex].wickets;
+}
+
+double MatchEngine::GetCurrentRunRate() const {
+    const InningsTotals& totals = inningsTotals[currentInningsIndex];
+    if (totals.legalBalls == 0) return 0.0;
+    
+    return (totals.runs * 6.0) / totals.legalBalls;
+}
+
+int MatchEngine::GetRequiredRuns() const {
+    if (target <= 0) {
+        return 0;
+    }
+    return std::max(0, target - inningsTotals[currentInningsIndex].runs);
+}
+
+int MatchEngine::GetRemainingOvers() const {
+    return WithInningsFormat([this](auto format) {
+        using Format = decltype(format);
+        // Tests are limited by time rather than by overs per innings
+        if constexpr (Format::IsTimed) {
+            return (Format::MatchBalls - GetMatchBallsBowled()) / 6;
+        } else {
+            return GetAllottedOversFor<Format>(currentInningsIndex) - matchState.currentOver;
+        }
+    });
+}
+
+bool MatchEngine::IsPowerplay() const {
+    return WithInningsFormat([this](auto format) {
+        return matchState.currentOver < decltype(format)::PowerplayOvers;
+    });
+}
+
+const std::string& MatchEngine::GetTeamName(TeamId id) const {
+    static const std::string empty;
+    if (id == 0 && team1) return team1->GetName();
+    if (id == 1 && team2) return team2->GetName();
+    return empty;
+}
+
+BallEvent MatchEngine::ResolveBallEvent(const BallRecord& ball) const {
+    BallEvent event;
+    event.result = ball.GetResult();
+    event.wicketType = ball.GetWicketType();
+    event.runs = ball.runs;
+    event.striker = GetPlayerName(ball.striker);
+    event.nonStriker = GetPlayerName(ball.nonStriker);
+    event.bowler = GetPlayerName(ball.bowler);
+    event.fielder = GetPlayerName(ball.fielder);
+    event.fieldingPosition = static_cast<FieldingPosition>(ball.fieldingPosition);
+    event.isExtra = ball.IsExtra();
+    event.commentary = GetBallCommentary(ball);
+    event.winProbability = -1.0;
+    event.winProbabilityIsCurrent = false;
+    return event;
+}
+
+std::string MatchEngine::GetResultDescription() const {
+    std::string description;
+    ScorecardWriter::WriteResult(*this, description);
+    return description;
+}
+
+void MatchEngine::UpdatePlayerStats(const BallRecord& ball) {
+    BallResult result = ball.GetResult();
+    PlayerMatchStats* lines = &playerStats[ball.innings * players.size()];
+    PlayerMatchStats& batter = lines[ball.striker];
+    PlayerMatchStats& bowler = lines[ball.bowler];
+    
+    if (result != BallResult::WIDE) {
+        batter.ballsFaced++;
+    }
+    if (!ball.IsExtra()) {
+        batter.runs += ball.runs;
+        batter.fours += result == BallResult::FOUR;
+        batter.sixes += result == BallResult::SIX;
+    }
+    if (ball.IsWicket()) {
+        batter.dismissed = true;
+        batter.howOut = ball.wicketType;
+        batter.dismissedBy = result == BallResult::RUN_OUT ? NoPlayer : ball.bowler;
+    }
+    
+    bool charged = result != BallResult::BYE && result != BallResult::LEG_BYE;
+    if (charged) {
+        bowler.runsConceded += ball.runs;
+        overRunsCharged += ball.runs;
+    }
+    bowler.wickets += result == BallResult::WICKET;
+    if (!ball.IsLegal()) {
+        return;
+    }
+    bowler.ballsBowled++;
+    
+    // The over is done: a maiden if nothing in it was charged to the bowler
+    if (ball.ball == 5) {
+        bowler.maidens += overRunsCharged == 0;
+        overRunsCharged = 0;
+    }
+}
+
+void MatchEngine::UpdateInningsProgress(const BallRecord& ball, PlayerId nextStriker, PlayerId nextNonStriker) {
+    InningsProgress& progress = inningsProgress[ball.innings];
+    if (!progress.HasCurrentPartnership()) {
+        if (progress.wicketCount >= InningsProgress::MaxWickets) {
+            return;
+        }
+        // Rebuilding from records: the pair is whoever faced this ball
+        OpenPartnership(progress, ball.striker, ball.nonStriker);
+    }
+    
+    Partnership& partnership = progress.partnerships[progress.partnershipCount - 1];
+    partnership.runs += ball.runs;
+    partnership.legalBalls += ball.IsLegal();
+    CreditPartnership(partnership, ball.striker, ball.IsExtra() ? 0 : ball.runs,
+                      ball.GetResult() != BallResult::WIDE);
+    
+    if (ball.IsWicket()) {
+        RecordFallOfWicket(progress, ball.striker, ball.over * 6 + ball.ball + ball.IsLegal());
+        if (nextStriker != NoPlayer && nextNonStriker != NoPlayer && progress.wicketCount < InningsProgress::MaxWickets) {
+            OpenPartnership(progress, nextStriker, nextNonStriker);
+        }
+    }
+}
+
+void MatchEngine::OpenPartnership(InningsProgress& progress, PlayerId striker, PlayerId nonStriker) {
+    Partnership partnership{};
+    partnership.batters[0].id = striker;
+    partnership.batters[1].id = nonStriker;
+    if (progress.partnershipCount > 0) {
+        // The surviving batter goes first and carries their innings over
+        const Partnership& previous = progress.partnerships[progress.partnershipCount - 1];
+        for (const PartnershipBatter& batter : previous.batters) {
+            if (batter.id == nonStriker) {
+                std::swap(partnership.batters[0].id, partnership.batters[1].id);
+            }
+            if (batter.id == striker || batter.id == nonStriker) {
+                partnership.batters[0].inningsRuns = batter.inningsRuns;
+                partnership.batters[0].inningsBalls = batter.inningsBalls;
+            }
+        }
+        partnership.startRuns = previous.startRuns + previous.runs;
+    }
+    progress.partnerships[progress.partnershipCount++] = partnership;
+}
+
+void MatchEngine::CreditPartnership(Partnership& partnership, PlayerId batter, int batterRuns, int ballsFaced) {
+    for (PartnershipBatter& slot : partnership.batters) {
+        if (slot.id == batter) {
+            slot.runs += batterRuns;
+            slot.balls += ballsFaced;
+            slot.inningsRuns += batterRuns;
+            slot.inningsBalls += ballsFaced;
+            return;
+        }
+    }
+}
+
+void MatchEngine::RecordFallOfWicket(InningsProgress& progress, PlayerId batter, int legalBalls) {
+    const Partnership& partnership = progress.partnerships[progress.partnershipCount - 1];
+    FallOfWicket& fall = progress.fallOfWickets[progress.wicketCount++];
+    fall.batter = batter;
+    fall.runs = static_cast<uint16_t>(partnership.startRuns + partnership.runs);
+    fall.legalBalls = static_cast<uint16_t>(legalBalls);
+    fall.batterRuns = 0;
+    fall.batterBalls = 0;
+    for (const PartnershipBatter& slot : partnership.batters) {
+        if (slot.id == batter) {
+            fall.batterRuns = slot.inningsRuns;
+            fall.batterBalls = slot.inningsBalls;
+        }
+    }
+}
+
+PlayerMatchStats MatchEngine::GetPlayerMatchLine(PlayerId id) const {
+    PlayerMatchStats total{};
+    total.dismissedBy = NoPlayer;
+    for (int i = 0; i < MaxInnings; ++i) {
+        const PlayerMatchStats& line = GetPlayerInningsLine(i, id);
+        total.runs += line.runs;
+        total.ballsFaced += line.ballsFaced;
+        total.fours += line.fours;
+        total.sixes += line.sixes;
+        total.ballsBowled += line.ballsBowled;
+        total.runsConceded += line.runsConceded;
+        total.maidens += line.maidens;
+        total.wickets += line.wickets;
+        if (line.dismissed) {
+            total.dismissed = true;
+            total.howOut = line.howOut;
+            total.dismissedBy = line.dismissedBy;
+        }
+    }
+    return total;
+}
+
+std::map<std::string, PlayerStats> MatchEngine::GetPlayerMatchStats() const {
+    std::map<std::string, PlayerStats> stats;
+    for (PlayerId id = 0; id < players.size(); ++id) {
+        const PlayerMatchStats line = GetPlayerMatchLine(id);
+        PlayerStats player{};
+        player.matches = 1;
+        player.runs = line.runs;
+        player.strikeRate = line.GetStrikeRate();
+        player.fours = line.fours;
+        player.sixes = line.sixes;
+        player.overs = line.GetOvers();
+        player.wickets = line.wickets;
+        player.bowlingAverage = line.wickets > 0 ? static_cast<double>(line.runsConceded) / line.wickets : 0.0;
+        player.economyRate = line.GetEconomy();
+        player.bowlingStrikeRate = line.wickets > 0 ? static_cast<double>(line.ballsBowled) / line.wickets : 0.0;
+        player.tenWickets = line.wickets >= 10 ? 1 : 0;
+        
+        // Milestones and bests are per innings; a Test has up to two
+        int dismissals = 0;
+        for (int i = 0; i < MaxInnings; ++i) {
+            const PlayerMatchStats& innings = GetPlayerInningsLine(i, id);
+            if (innings.ballsFaced > 0 || innings.dismissed) {
+                player.innings++;
+                player.highestScore = std::max<int>(player.highestScore, innings.runs);
+                player.fifties += innings.runs >= 50 && innings.runs < 100;
+                player.hundreds += innings.runs >= 100;
+            }
+            dismissals += innings.dismissed;
+            player.fiveWickets += innings.wickets >= 5;
+            player.bestBowling = std::max<int>(player.bestBowling, innings.wickets);
+        }
+        player.average = dismissals > 0 ? static_cast<double>(line.runs) / dismissals : 0.0;
+        stats[names->GetName(id)] = player;
+    }
+    return stats;
+}
+
+void MatchEngine::SetFieldingPositions(const std::map<std::string, FieldingPosition>& positions) {
+    // TODO: Implement fielding positions
+}
+
+void MatchEngine::SetBowlingChange(const std::string& newBowler) {
+    PlayerId id = names->Find(newBowler);
+    if (id != NoPlayer) {
+        matchState.bowler = id;
+    }
+}
+
+void MatchEngine::SetBattingOrder(const std::vector<std::string>& order) {
+    // TODO: Implement batting order change
+}
+
+void MatchEngine::PauseMatch() {
+    isPaused = true;
+}
+
+void MatchEngine::ResumeMatch() {
+    isPaused = false;
+}
+
+void MatchEngine::EndMatch() {
+    isMatchComplete = true;
+}
+
+void MatchEngine::AddCommentary(const std::string& commentary) {
+    // Keep manual lines in order with the balls bowled before them
+    CatchUpCommentary();
+    this->commentary.push_back(commentary);
+}
+
+const std::vector<std::string>& MatchEngine::GetCommentary() const {
+    CatchUpCommentary();
+    return commentary;
+}
+
+void MatchEngine::ClearCommentary() {
+    commentary.clear();
+    describedBalls = GetLoggedBallCount();
+}
+
+std::string MatchEngine::DescribeBall(const BallRecord& ball) const {
+    std::string line = std::to_string(ball.over) + "." + std::to_string(ball.ball + 1) + " ";
+    line += GetPlayerName(ball.bowler);
+    line += " to ";
+    line += GetPlayerName(ball.striker);
+    line += ", ";
+    line += GetBallCommentary(ball);
+    
+    // Wickets close with the batter's score and the fall of wicket
+    if (ball.IsWicket()) {
+        const InningsProgress& progress = inningsProgress[ball.innings];
+        for (int i = 0; i < progress.wicketCount; ++i) {
+            const FallOfWicket& fall = progress.fallOfWickets[i];
+            if (fall.batter == ball.striker) {
+                line += " " + GetPlayerName(fall.batter) + " " + std::to_string(fall.batterRuns) + " (" +
+                        std::to_string(fall.batterBalls) + "), " + std::to_string(fall.runs) + "/" + std::to_string(i + 1);
+                break;
+            }
+        }
+    }
+    return line;
+}
+
+void MatchEngine::CatchUpCommentary() const {
+    if (describedBalls < replayPrefixBalls) {
+        LoadBallHistoryPrefix();
+    }
+    for (; describedBalls < GetLoggedBallCount(); ++describedBalls) {
+        commentary.push_back(DescribeBall(ballHistory[describedBalls - replayPrefixBalls]));
+    }
+}
+
+const BallLog& MatchEngine::GetBallHistory() const {
+    LoadBallHistoryPrefix();
+    return ballHistory;
+}
+
+void MatchEngine::LoadBallHistoryPrefix() const {
+    if (!replayPrefix) {
+        return;
+    }
+    
+    // On a failed read the prefix stays pending and the log stays short
+    std::vector<BallRecord> records;
+    if (!replayPrefix->ReadBalls(0, replayPrefixBalls, records)) {
+        return;
+    }
+    BallLog log;
+    for (const BallRecord& ball : records) {
+        log.Append(ball);
+    }
+    for (const BallRecord& ball : ballHistory) {
+        log.Append(ball);
+    }
+    ballHistory = std::move(log);
+    replayPrefix.reset();
+    replayPrefixBalls = 0;
+}
+
+void MatchEngine::CalculateMatchStats() {
+    // TODO: Implement match statistics calculation
+}
+
+std::string MatchEngine::GenerateScorecard() const {
+    std::string scorecard;
+    ScorecardWriter::Write(*this, ScorecardFormat::TEXT, scorecard);
+    return scorecard;
+}
+
+std::string MatchEngine::GenerateMatchReport() const {
+    return GenerateScorecard();
+}
+
+void MatchEngine::EnableWinProbability(bool enabled, int simulationsPerState) {
+    winProbability = enabled ? std::make_unique<WinProbabilityEngine>(simulationsPerState) : nullptr;
+    ResetWinProbability();
+}
+
+void MatchEngine::ResetWinProbability() {
+    if (!winProbability) {
+        return;
+    }
+    
+    // The worker keeps its own copy of the fixture, so balls only send state
+    auto configuration = std::make_unique<MatchEngine>();
+    CopyConfigurationTo(*configuration);
+    configuration->fidelity = SimulationFidelity::SCORE_ONLY;
+    winProbability->Clear(std::move(configuration));
+}
+
+void MatchEngine::EstimateWinProbability(double& probability, bool& isCurrent) {
+    if (!winProbability) {
+        return;
+    }
     
-    // Set initial teams
-    matchState.battingTeam = team1->GetName();
-    matchState.bowlingTeam = team2->GetName();
+    // A finished match needs no estimate
+    if (isMatchComplete) {
+        probability = matchState.isTie ? 0.5 : (matchState.winner == matchState.battingTeam ? 1.0 : 0.0);
+        isCurrent = true;
+        return;
+    }
     
-    // Set initial players
-    if (!team1->GetBattingOrder().empty()) {
-        matchState.striker = team1->GetBattingOrder()[0]->GetName();
-        if (team1->GetBattingOrder().size() > 1) {
-            matchState.nonStriker = team1->GetBattingOrder()[1]->GetName();
+    // Estimate in the background; the worker also works through the states
+    // the likely next balls lead to, so the next event usually finds its
+    // value cached
+    uint64_t key = GetWinStateKey();
+    bool isCached = winProbability->Lookup(key, probability);
+    if (isCached) {
+        isCurrent = true;
+    } else {
+        // Meanwhile report the newest estimate we have
+        double team1Probability = winProbability->GetLatestTeam1Probability();
+        if (team1Probability >= 0.0) {
+            probability = matchState.battingTeam == 0 ? team1Probability : 1.0 - team1Probability;
         }
     }
-    
-    if (!team2->GetBowlingOrder().empty()) {
-        matchState.bowler = team2->GetBowlingOrder()[0]->GetName();
+    if (!isCached || !isInningsComplete) {
+        winProbability->Submit(key, TakeScoreState(), matchState.battingTeam, !isInningsComplete);
     }
-    
-    std::cout << "Match initialized: " << team1->GetName() << " vs " << team2->GetName() 
-              << " at " << venue->GetName() << std::endl;
 }
 
-void MatchEngine::SetPitchConditions(const PitchConditions& conditions) {
-    pitchConditions = conditions;
+uint64_t MatchEngine::GetWinStateKey() const {
+    const InningsTotals& totals = inningsTotals[currentInningsIndex];
+    if (matchType == MatchType::TEST) {
+        // Earlier innings matter through the deficit the batting side started from
+        int ballsRemaining = TestPolicy::MatchBalls - GetMatchBallsBowled();
+        int deficit = GetTeamRuns(1 - battingSide) - (GetTeamRuns(battingSide) - totals.runs);
+        return WinProbabilityEngine::MakeStateKey(currentInningsIndex, totals.runs, totals.wickets,
+                                                  ballsRemaining, deficit);
+    }
+    int ballsRemaining = GetRemainingOvers() * 6 - matchState.currentBall;
+    return WinProbabilityEngine::MakeStateKey(currentInningsIndex, totals.runs, totals.wickets, 
+                                              ballsRemaining, target);
 }
 
-void MatchEngine::SetWeatherConditions(const WeatherConditions& weather) {
-    weatherConditions = weather;
+MatchEngine::Snapshot MatchEngine::TakeSnapshot() const {
+    LoadBallHistoryPrefix();
+    Snapshot snapshot;
+    snapshot.state = matchState;
+    snapshot.inningsTotals = inningsTotals;
+    snapshot.innings = innings;
+    snapshot.ballHistory = ballHistory;
+    snapshot.playerStats = playerStats;
+    snapshot.inningsProgress = inningsProgress;
+    snapshot.overRunsCharged = overRunsCharged;
+    snapshot.rainOversLost = rainOversLost;
+    snapshot.rainResourcesLost = rainResourcesLost;
+    snapshot.rainInterruptions = rainInterruptions;
+    snapshot.battingSide = battingSide;
+    snapshot.nextBatterIndex = nextBatterIndex;
+    snapshot.bowlerIndex = bowlerIndex;
+    snapshot.target = target;
+    snapshot.currentInningsIndex = currentInningsIndex;
+    snapshot.deliveryIndex = deliveryIndex;
+    snapshot.pitchWear = pitchWear;
+    snapshot.pitchDrying = pitchDrying;
+    snapshot.isInningsComplete = isInningsComplete;
+    snapshot.isMatchComplete = isMatchComplete;
+    snapshot.hasSkippedBalls = hasSkippedBalls;
+    snapshot.randomSeed = randomSeed;
+    snapshot.matchIndex = matchIndex;
+    return snapshot;
 }
 
-void MatchEngine::SimulateBall() {
-    if (isPaused || isMatchComplete) {
-        return;
+void MatchEngine::RestoreSnapshot(const Snapshot& snapshot) {
+    if (pitchWear != snapshot.pitchWear || pitchDrying != snapshot.pitchDrying) {
+        outcomeTablesDirty = true;
     }
     
-    // Generate ball event
-    BallEvent event = SimulateBallResult();
+    matchState = snapshot.state;
+    inningsTotals = snapshot.inningsTotals;
+    innings = snapshot.innings;
+    ballHistory = snapshot.ballHistory;
+    replayPrefix.reset();
+    replayPrefixBalls = 0;
+    playerStats = snapshot.playerStats;
+    inningsProgress = snapshot.inningsProgress;
+    overRunsCharged = snapshot.overRunsCharged;
+    rainOversLost = snapshot.rainOversLost;
+    rainResourcesLost = snapshot.rainResourcesLost;
+    rainInterruptions = snapshot.rainInterruptions;
+    battingSide = snapshot.battingSide;
+    nextBatterIndex = snapshot.nextBatterIndex;
+    bowlerIndex = snapshot.bowlerIndex;
+    target = snapshot.target;
+    currentInningsIndex = snapshot.currentInningsIndex;
+    deliveryIndex = snapshot.deliveryIndex;
+    pitchWear = snapshot.pitchWear;
+    pitchDrying = snapshot.pitchDrying;
+    isInningsComplete = snapshot.isInningsComplete;
+    isMatchComplete = snapshot.isMatchComplete;
+    hasSkippedBalls = snapshot.hasSkippedBalls;
+    randomSeed = snapshot.randomSeed;
+    matchIndex = snapshot.matchIndex;
     
-    // Update match state
-    UpdateMatchState(event);
+    commentary.clear();
+    describedBalls = 0;
+}
+
+MatchEngine::ScoreState MatchEngine::TakeScoreState() const {
+    ScoreState state;
+    state.inningsTotals = inningsTotals;
+    state.rainOversLost = rainOversLost;
+    state.rainResourcesLost = rainResourcesLost;
+    state.striker = matchState.striker;
+    state.nonStriker = matchState.nonStriker;
+    state.bowler = matchState.bowler;
+    state.currentOver = matchState.currentOver;
+    state.currentBall = matchState.currentBall;
+    state.battingSide = battingSide;
+    state.nextBatterIndex = nextBatterIndex;
+    state.bowlerIndex = bowlerIndex;
+    state.target = target;
+    state.currentInningsIndex = currentInningsIndex;
+    state.deliveryIndex = deliveryIndex;
+    state.pitchWear = pitchWear;
+    state.pitchDrying = pitchDrying;
+    state.isInningsComplete = isInningsComplete;
+    state.randomSeed = randomSeed;
+    state.matchIndex = matchIndex;
+    return state;
+}
+
+void MatchEngine::RestoreScoreState(const ScoreState& state) {
+    if (pitchWear != state.pitchWear || pitchDrying != state.pitchDrying) {
+        pitchWear = state.pitchWear;
+        pitchDrying = state.pitchDrying;
+        outcomeTablesDirty = true;
+    }
     
-    // Add to ball history
-    ballHistory.push_back(event);
+    inningsTotals = state.inningsTotals;
+    rainOversLost = state.rainOversLost;
+    rainResourcesLost = state.rainResourcesLost;
+    rainInterruptions.clear(); // the state keeps only where rain left each innings
+    battingSide = state.battingSide;
+    nextBatterIndex = state.nextBatterIndex;
+    bowlerIndex = state.bowlerIndex;
+    target = state.target;
+    currentInningsIndex = state.currentInningsIndex;
+    deliveryIndex = state.deliveryIndex;
+    isInningsComplete = state.isInningsComplete;
+    isMatchComplete = false;
+    randomSeed = state.randomSeed;
+    matchIndex = state.matchIndex;
     
-    // Add commentary
-    AddCommentary(event.commentary);
+    matchState = MatchState();
+    matchState.matchType = matchType;
+    matchState.winner = NoTeam;
+    matchState.format = GetInningsFormat();
+    matchState.currentInnings = currentInningsIndex + 1;
+    matchState.currentOver = state.currentOver;
+    matchState.currentBall = state.currentBall;
+    matchState.striker = state.striker;
+    matchState.nonStriker = state.nonStriker;
+    matchState.bowler = state.bowler;
+    matchState.battingTeam = static_cast<TeamId>(battingSide);
+    matchState.bowlingTeam = static_cast<TeamId>(1 - battingSide);
     
-    // Call callback if set
-    if (ballEventCallback) {
-        ballEventCallback(event);
+    // Innings records carry only totals, so rebuild them from the state
+    innings.clear();
+    for (int i = 0; i <= currentInningsIndex; ++i) {
+        const InningsTotals& totals = inningsTotals[i];
+        int side = totals.battingSide;
+        Innings record{};
+        record.inningsNumber = i + 1;
+        record.battingTeam = GetTeamName(static_cast<TeamId>(side));
+        record.bowlingTeam = GetTeamName(static_cast<TeamId>(1 - side));
+        record.totalRuns = totals.runs;
+        record.totalWickets = totals.wickets;
+        record.totalOvers = totals.legalBalls / 6;
+        record.runRate = totals.legalBalls > 0 ? totals.runs * 6.0 / totals.legalBalls : 0.0;
+        record.isComplete = i < currentInningsIndex || isInningsComplete;
+        innings.push_back(record);
     }
-    
-    // Update player stats
-    UpdatePlayerStats(event);
 }
 
-void MatchEngine::SimulateOver() {
-    for (int i = 0; i < 6; ++i) {
-        SimulateBall();
-        if (isMatchComplete) break;
-    }
+void MatchEngine::CopyConfigurationTo(MatchEngine& engine) const {
+    // Everything that defines the fixture, but none of its progress
+    engine.team1 = team1;
+    engine.team2 = team2;
+    engine.venue = venue;
+    engine.matchType = matchType;
+    engine.superOverOnTie = superOverOnTie;
+    engine.rainChance = rainChance;
+    engine.rainDelayMinutes = rainDelayMinutes;
+    engine.rainDelayedStartMinutes = rainDelayedStartMinutes;
+    engine.lineups[0] = lineups[0];
+    engine.lineups[1] = lineups[1];
+    engine.names = names;
+    engine.players = players;
+    engine.outcomeTables = outcomeTables;
+    engine.outcomeTablesDirty = outcomeTablesDirty;
+    engine.pitchConditions = pitchConditions;
+    engine.weatherConditions = weatherConditions;
+    engine.pitchWear = pitchWear;
+    engine.pitchDrying = pitchDrying;
 }
 
-void MatchEngine::SimulateInnings() {
-    int maxOvers = (matchType == MatchType::T20) ? 20 : 
-                   (matchType == MatchType::ODI) ? 50 : 90;
+std::unique_ptr<MatchEngine> MatchEngine::Fork(uint64_t branch) const {
+    auto fork = std::make_unique<MatchEngine>();
+    CopyConfigurationTo(*fork);
+    fork->fidelity = fidelity;
+    fork->RestoreSnapshot(TakeSnapshot());
     
-    for (int over = 0; over < maxOvers; ++over) {
-        SimulateOver();
-        if (isMatchComplete) break;
+    // Past balls are not the fork's to describe
+    fork->describedBalls = ballHistory.Size();
+    if (branch != 0) {
+        fork->randomSeed = RandomService::Mix(randomSeed ^ RandomService::Mix(branch));
     }
+    return fork;
 }
 
-void MatchEngine::SimulateMatch() {
-    // Simulate first innings
-    SimulateInnings();
-    
-    if (!isMatchComplete) {
-        // Switch teams for second innings
-        matchState.format = MatchFormat::SECOND_INNINGS;
-        matchState.battingTeam = team2->GetName();
-        matchState.bowlingTeam = team1->GetName();
-        
-        // Simulate second innings
-        SimulateInnings();
+bool MatchEngine::SaveReplay(const std::string& path, int checkpointInterval) const {
+    // Fast-forwarded sessions left no records to replay
+    if (hasSkippedBalls) {
+        return false;
+    }
+    checkpointInterval = std::max(1, std::min(checkpointInterval, 0xFFFF));
+    LoadBallHistoryPrefix();
+    
+    ReplayHeader header{};
+    header.checkpointInterval = static_cast<uint16_t>(checkpointInterval);
+    header.randomSeed = randomSeed;
+    header.team1Fingerprint = GetLineupFingerprint(0);
+    header.team2Fingerprint = GetLineupFingerprint(1);
+    header.venueFingerprint = GetVenueFingerprint();
+    header.matchIndex = matchIndex;
+    header.winMargin = static_cast<uint16_t>(matchState.winMargin);
+    header.matchType = static_cast<uint8_t>(matchType);
+    header.winner = matchState.winner;
+    header.isTie = matchState.isTie;
+    header.wonByRuns = matchState.wonByRuns;
+    header.isMatchComplete = isMatchComplete;
+    header.inningsCount = static_cast<uint8_t>(innings.size());
+    header.rainChance = rainChance;
+    header.rainDelayMinutes = rainDelayMinutes;
+    header.rainDelayedStartMinutes = rainDelayedStartMinutes;
+    for (int i = 0; i < MaxInnings; ++i) {
+        header.totals[i] = ReplayTotals{
+            static_cast<uint16_t>(inningsTotals[i].runs),
+            static_cast<uint16_t>(inningsTotals[i].legalBalls),
+            static_cast<uint16_t>(inningsTotals[i].extras),
+            static_cast<uint8_t>(inningsTotals[i].wickets),
+            static_cast<uint8_t>(inningsTotals[i].battingSide)
+        };
+    }
+    
+    // Checkpoints come from replaying the records themselves, so loading one
+    // always agrees with replaying up to it. Each also keeps the player lines,
+    // partnerships and the runs so far in its over, for the maiden check.
+    std::vector<ReplayCheckpoint> checkpoints;
+    std::vector<ReplayCheckpointState> states;
+    std::unique_ptr<MatchEngine> replay = Fork();
+    replay->fidelity = SimulationFidelity::SCORE_ONLY;
+    replay->recordedRain = &rainInterruptions;
+    replay->ResetMatch();
+    for (size_t i = 0; i < ballHistory.Size(); ++i) {
+        replay->ReplayBall(ballHistory[i]);
+        if ((i + 1) % checkpointInterval == 0) {
+            checkpoints.push_back(replay->MakeCheckpoint(static_cast<uint32_t>(i + 1)));
+            states.push_back(ReplayCheckpointState{static_cast<uint32_t>(replay->overRunsCharged),
+                                                   replay->playerStats, replay->inningsProgress});
+        }
     }
     
-    DetermineMatchResult();
+    return MatchReplay::Write(path, header, ballHistory, checkpoints, rainInterruptions, states);
 }
 
-int MatchEngine::GetCurrentScore() const {
-    // Calculate from ball history
-    int score = 0;
-    for (const auto& ball : ballHistory) {
-        score += ball.runs;
-    }
-    return score;
+bool MatchEngine::LoadReplay(const std::string& path, uint32_t ballCount) {
+    MatchReplay replay;
+    return replay.Open(path) && LoadReplay(replay, ballCount);
 }
 
-int MatchEngine::GetCurrentWickets() const {
-    int wickets = 0;
-    for (const auto& ball : ballHistory) {
-        if (ball.result == BallResult::WICKET) {
-            wickets++;
+bool MatchEngine::LoadReplay(MatchReplay& replay, uint32_t ballCount) {
+    if (!replay.IsOpen()) {
+        return false;
+    }
+    
+    const ReplayHeader& header = replay.GetHeader();
+    if (header.matchType != static_cast<uint8_t>(matchType) ||
+        header.team1Fingerprint != GetLineupFingerprint(0) ||
+        header.team2Fingerprint != GetLineupFingerprint(1) ||
+        header.venueFingerprint != GetVenueFingerprint()) {
+        return false;
+    }
+    
+    ballCount = std::min(ballCount, header.ballCount);
+    
+    // With the checkpoint's player lines and partnerships, only the records
+    // after it are read
+    const ReplayCheckpoint* checkpoint = replay.FindCheckpoint(ballCount);
+    ReplayCheckpointState checkpointState;
+    std::unique_ptr<MatchReplay> prefixSource;
+    if (checkpoint) {
+        if (!replay.ReadCheckpointState(*checkpoint, checkpointState) ||
+            checkpointState.playerStats.size() != MaxInnings * players.size()) {
+            return false;
+        }
+        // Earlier records are read later through a handle of our own
+        prefixSource = std::make_unique<MatchReplay>();
+        if (!prefixSource->Open(replay.GetPath())) {
+            checkpoint = nullptr;
         }
     }
-    return wickets;
-}
-
-double MatchEngine::GetCurrentRunRate() const {
-    int totalBalls = ballHistory.size();
-    if (totalBalls == 0) return 0.0;
+    uint32_t first = checkpoint ? checkpoint->ball : 0;
+    std::vector<BallRecord> records;
+    if (!replay.ReadBalls(first, ballCount - first, records)) {
+        return false;
+    }
+    
+    // Callbacks belong to live play, not to rebuilding state. Rain comes
+    // from the file; the settings are for play that continues from here.
+    SimulationFidelity liveFidelity = fidelity;
+    fidelity = SimulationFidelity::SCORE_ONLY;
+    randomSeed = header.randomSeed;
+    matchIndex = header.matchIndex;
+    rainChance = header.rainChance;
+    rainDelayMinutes = header.rainDelayMinutes;
+    rainDelayedStartMinutes = header.rainDelayedStartMinutes;
+    recordedRain = &replay.GetRainInterruptions();
+    ResetMatch();
     
-    int totalRuns = GetCurrentScore();
-    return (totalRuns * 6.0) / totalBalls;
+    // Jump to the nearest checkpoint and apply only the records after it;
+    // earlier records stay on disk until something asks for them
+    if (checkpoint) {
+        playerStats = checkpointState.playerStats;
+        inningsProgress = checkpointState.inningsProgress;
+        overRunsCharged = static_cast<int>(checkpointState.overRunsCharged);
+        ApplyCheckpoint(*checkpoint);
+        for (const RainInterruption& rain : *recordedRain) {
+            if (rain.innings < currentInningsIndex ||
+                (rain.innings == currentInningsIndex && rain.over <= matchState.currentOver)) {
+                rainInterruptions.push_back(rain);
+            }
+        }
+        replayPrefix = std::move(prefixSource);
+        replayPrefixBalls = first;
+    }
+    for (uint32_t i = first; i < ballCount; ++i) {
+        ReplayBall(records[i - first]);
+    }
+    
+    if (ballCount == header.ballCount && header.isMatchComplete && !isMatchComplete) {
+        // An innings washed out before its first ball left no records
+        while (isInningsComplete && !IsResultDecided() && static_cast<int>(innings.size()) < header.inningsCount) {
+            StartInnings(GetNextBattingSide());
+        }
+        if (!isInningsComplete) {
+            EndInnings();
+        }
+        DetermineMatchResult();
+    }
+    recordedRain = nullptr;
+    fidelity = liveFidelity;
+    return true;
 }
 
-int MatchEngine::GetRequiredRuns() const {
-    // TODO: Implement based on match format
-    return 0;
+void MatchEngine::SetBallEventCallback(std::function<void(const BallEvent&)> callback) {
+    ballEventCallback = callback;
 }
 
-int MatchEngine::GetRemainingOvers() const {
-    int maxOvers = (matchType == MatchType::T20) ? 20 : 
-                   (matchType == MatchType::ODI) ? 50 : 90;
-    return maxOvers - matchState.currentOver;
+void MatchEngine::SetInningsEndCallback(std::function<void(const Innings&)> callback) {
+    inningsEndCallback = callback;
 }
 
-void MatchEngine::UpdatePlayerStats(const BallEvent& event) {
-    // TODO: Implement player stats update
+void MatchEngine::SetMatchEndCallback(std::function<void(const std::string&)> callback) {
+    matchEndCallback = callback;
 }
 
-std::map<std::string, PlayerStats> MatchEngine::GetPlayerMatchStats() const {
-    // TODO: Implement player match stats
-    return std::map<std::string, PlayerStats>();
+void MatchEngine::SetEventBus(std::shared_ptr<MatchEventBus> bus) {
+    eventBus = std::move(bus);
 }
 
-void MatchEngine::SetFieldingPositions(const std::map<std::string, FieldingPosition>& positions) {
-    // TODO: Implement fielding positions
+void MatchEngine::PublishEvent(MatchEventType type, const BallRecord* ball, double winProbability,
+                               bool winProbabilityIsCurrent) {
+    MatchEvent event{};
+    event.type = type;
+    event.battingTeam = matchState.battingTeam;
+    event.winner = matchState.winner;
+    event.isTie = matchState.isTie;
+    event.wonByRuns = matchState.wonByRuns;
+    event.winMargin = static_cast<uint16_t>(matchState.winMargin);
+    event.matchIndex = matchIndex;
+    if (ball) {
+        event.ball = *ball;
+    }
+    event.totals = inningsTotals[currentInningsIndex];
+    event.winProbability = winProbability;
+    event.winProbabilityIsCurrent = winProbabilityIsCurrent;
+    eventBus->Publish(event);
 }
 
-void MatchEngine::SetBowlingChange(const std::string& newBowler) {
-    matchState.bowler = newBowler;
+void MatchEngine::SetPlaybackSpeed(PlaybackSpeed speed) {
+    switch (speed) {
+        case PlaybackSpeed::BROADCAST: SetPlaybackMultiplier(1.0f); break;
+        case PlaybackSpeed::FAST: SetPlaybackMultiplier(10.0f); break;
+        case PlaybackSpeed::INSTANT: SetPlaybackMultiplier(0.0f); break;
+    }
 }
 
-void MatchEngine::SetBattingOrder(const std::vector<std::string>& order) {
-    // TODO: Implement batting order change
+void MatchEngine::SetPlaybackMultiplier(float multiplier) {
+    playbackMultiplier = std::max(0.0f, multiplier);
+    stepAccumulator = 0.0;
 }
 
-void MatchEngine::PauseMatch() {
-    isPaused = true;
+void MatchEngine::Update(float deltaTime) {
+    if (!team1 || !team2 || isPaused || isMatchComplete) {
+        return;
+    }
+    
+    bool instant = playbackMultiplier <= 0.0f;
+    if (!instant) {
+        stepAccumulator += std::max(0.0f, deltaTime) * static_cast<double>(playbackMultiplier);
+    }
+    
+    // Balls the budget could not fit stay owed, but only up to an over's
+    // worth, so a long stall does not turn into a burst of catch-up frames
+    const double step = BroadcastSecondsPerBall;
+    stepAccumulator = std::min(stepAccumulator, step * 6.0);
+    
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(static_cast<long long>(frameBudgetMs * 1000.0f));
+    while (!isMatchComplete && !isPaused && (instant || stepAccumulator >= step)) {
+        AdvanceLiveMatch();
+        if (!instant) {
+            stepAccumulator -= step;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    
+    PublishRenderState();
 }
 
-void MatchEngine::ResumeMatch() {
-    isPaused = false;
+MatchBoundary MatchEngine::Advance(MatchBoundary until) {
+    MatchBoundary reached = MatchBoundary::NONE;
+    while (!isMatchComplete && !isPaused && reached < until) {
+        reached = AdvanceLiveMatch();
+    }
+    
+    PublishRenderState();
+    return isMatchComplete ? MatchBoundary::MATCH : reached;
 }
 
-void MatchEngine::EndMatch() {
-    isMatchComplete = true;
+MatchBoundary MatchEngine::AdvanceLiveMatch() {
+    // Same progression as SimulateMatch, one step at a time. An innings can
+    // also end without a ball, when rain or a short line-up stops it.
+    if (isInningsComplete) {
+        AdvanceInnings();
+        return isMatchComplete ? MatchBoundary::MATCH :
+               isInningsComplete ? MatchBoundary::INNINGS : MatchBoundary::NONE;
+    }
+    
+    int over = matchState.currentOver;
+    SimulateBall();
+    if (isInningsComplete) {
+        // The last innings settles the match on the ball that ends it
+        if (IsResultDecided()) {
+            DetermineMatchResult();
+        }
+        return isMatchComplete ? MatchBoundary::MATCH : MatchBoundary::INNINGS;
+    }
+    return matchState.currentOver != over ? MatchBoundary::OVER : MatchBoundary::BALL;
 }
 
-void MatchEngine::AddCommentary(const std::string& commentary) {
-    this->commentary.push_back(commentary);
+void MatchEngine::PublishRenderState() {
+    renderState.state = matchState;
+    renderState.totals = inningsTotals[currentInningsIndex];
+    renderState.target = target;
+    renderState.parScore = GetParScore();
+    renderState.currentInningsIndex = currentInningsIndex;
+    renderState.ballCount = static_cast<uint32_t>(GetLoggedBallCount());
+    renderState.isPowerplay = IsPowerplay();
+    const InningsProgress& progress = inningsProgress[currentInningsIndex];
+    renderState.hasPartnership = progress.HasCurrentPartnership();
+    if (renderState.hasPartnership) {
+        renderState.partnership = progress.GetCurrentPartnership();
+    }
+    if (!ballHistory.Empty()) {
+        renderState.lastBall = ballHistory.Back();
+    }
+    bool instant = playbackMultiplier <= 0.0f;
+    renderState.stepProgress = instant ? 0.0f : static_cast<float>(std::min(1.0, stepAccumulator / BroadcastSecondsPerBall));
 }
 
-void MatchEngine::ClearCommentary() {
+// Private helper methods
+void MatchEngine::ResetMatch() {
+    matchState = MatchState();
+    matchState.matchType = matchType;
+    matchState.isMatchComplete = false;
+    matchState.winner = NoTeam;
+    
+    innings.clear();
+    ballHistory.Clear();
+    replayPrefix.reset();
+    replayPrefixBalls = 0;
     commentary.clear();
+    describedBalls = 0;
+    inningsTotals.fill(InningsTotals{});
+    playerStats.assign(MaxInnings * players.size(), PlayerMatchStats{}); // keeps its capacity between matches
+    inningsProgress.fill(InningsProgress{});
+    isMatchComplete = false;
+    hasSkippedBalls = false;
+    rainOversLost.fill(0);
+    rainResourcesLost.fill(0);
+    rainInterruptions.clear();
+    target = 0;
+    stepAccumulator = 0.0;
+    
+    // Undo any wear from a previous run of this match
+    if (pitchWear != 0 || pitchDrying != 0) {
+        pitchWear = 0;
+        pitchDrying = 0;
+        outcomeTablesDirty = true;
+    }
+    
+    StartInnings(0);
 }
 
-void MatchEngine::CalculateMatchStats() {
-    // TODO: Implement match statistics calculation
+void MatchEngine::StartInnings(int side) {
+    battingSide = side;
+    const TeamLineup& batting = lineups[side];
+    const TeamLineup& bowling = lineups[1 - side];
+    
+    currentInningsIndex = static_cast<int>(innings.size());
+    inningsTotals[currentInningsIndex] = InningsTotals{};
+    inningsTotals[currentInningsIndex].battingSide = side;
+    deliveryIndex = 0;
+    
+    // Chasing side needs one more than the other side's total; in a Test
+    // only the fourth innings is a chase
+    if (matchType == MatchType::TEST) {
+        target = currentInningsIndex == 3 ? GetTeamRuns(1 - side) - GetTeamRuns(side) + 1 : 0;
+    } else {
+        target = currentInningsIndex % 2 == 1 ? inningsTotals[currentInningsIndex - 1].runs + 1 : 0;
+    }
+    
+    matchState.format = GetInningsFormat();
+    matchState.currentInnings = static_cast<int>(innings.size()) + 1;
+    matchState.currentOver = 0;
+    matchState.currentBall = 0;
+    matchState.battingTeam = static_cast<TeamId>(side);
+    matchState.bowlingTeam = static_cast<TeamId>(1 - side);
+    matchState.striker = batting.batting.size() > 0 ? batting.batting[0] : NoPlayer;
+    matchState.nonStriker = batting.batting.size() > 1 ? batting.batting[1] : NoPlayer;
+    matchState.bowler = bowling.bowling.empty() ? NoPlayer : bowling.bowling[0];
+    nextBatterIndex = 2;
+    bowlerIndex = 0;
+    overRunsCharged = 0;
+    isInningsComplete = false;
+    
+    InningsProgress& progress = inningsProgress[currentInningsIndex];
+    progress = InningsProgress{};
+    if (matchState.striker != NoPlayer && matchState.nonStriker != NoPlayer) {
+        OpenPartnership(progress, matchState.striker, matchState.nonStriker);
+    }
+    
+    Innings current{};
+    current.inningsNumber = matchState.currentInnings;
+    current.battingTeam = GetTeamName(matchState.battingTeam);
+    current.bowlingTeam = GetTeamName(matchState.bowlingTeam);
+    innings.push_back(current);
+    
+    // Rain rules for the main innings of a limited-overs match
+    if (matchType != MatchType::TEST && currentInningsIndex < 2) {
+        WithInningsFormat([this](auto format) { StartRainInningsFor<decltype(format)>(); });
+    }
 }
 
-std::string MatchEngine::GenerateScorecard() const {
-    std::ostringstream scorecard;
-    scorecard << "=== MATCH SCORECARD ===" << std::endl;
-    scorecard << team1->GetName() << " vs " << team2->GetName() << std::endl;
-    scorecard << "Venue: " << venue->GetName() << std::endl;
-    scorecard << "Format: " << (matchType == MatchType::T20 ? "T20" : 
-                               matchType == MatchType::ODI ? "ODI" : "Test") << std::endl;
-    scorecard << "Score: " << GetCurrentScore() << "/" << GetCurrentWickets() << std::endl;
-    scorecard << "Overs: " << matchState.currentOver << "." << matchState.currentBall << std::endl;
-    scorecard << "Run Rate: " << GetCurrentRunRate() << std::endl;
-    return scorecard.str();
+void MatchEngine::EndInnings() {
+    isInningsComplete = true;
+    
+    // Publish the running totals into the innings record
+    const InningsTotals& totals = inningsTotals[currentInningsIndex];
+    Innings& current = innings.back();
+    current.totalRuns = totals.runs;
+    current.totalWickets = totals.wickets;
+    current.totalOvers = matchState.currentOver;
+    current.runRate = totals.legalBalls > 0 ? totals.runs * 6.0 / totals.legalBalls : 0.0;
+    current.isComplete = true;
+    
+    if (fidelity == SimulationFidelity::FULL) {
+        if (eventBus) {
+            PublishEvent(MatchEventType::INNINGS_END, nullptr, -1.0, false);
+        }
+        if (inningsEndCallback) {
+            inningsEndCallback(current);
+        }
+    }
 }
 
-std::string MatchEngine::GenerateMatchReport() const {
-    return GenerateScorecard();
+uint64_t MatchEngine::GetLineupFingerprint(int side) const {
+    const Team* team = side == 0 ? team1 : team2;
+    uint64_t fingerprint = RandomService::HashName(team ? team->GetName() : "");
+    for (PlayerId id : lineups[side].batting) {
+        fingerprint = RandomService::Mix(fingerprint ^ RandomService::HashName(names->GetName(id)));
+    }
+    for (PlayerId id : lineups[side].bowling) {
+        fingerprint = RandomService::Mix(fingerprint ^ RandomService::HashName(names->GetName(id)) ^ 1);
+    }
+    return fingerprint;
 }
 
-void MatchEngine::SetBallEventCallback(std::function<void(const BallEvent&)> callback) {
-    ballEventCallback = callback;
+uint64_t MatchEngine::GetVenueFingerprint() const {
+    return venue ? RandomService::HashName(venue->GetName()) : 0;
 }
 
-void MatchEngine::SetInningsEndCallback(std::function<void(const Innings&)> callback) {
-    inningsEndCallback = callback;
+void MatchEngine::ReplayBall(const BallRecord& ball) {
+    // A record from the next innings means the previous one is over
+    if (ball.innings != currentInningsIndex) {
+        if (!isInningsComplete) {
+            EndInnings();
+        }
+        StartInnings(GetNextBattingSide());
+    }
+    
+    deliveryIndex++;
+    UpdateMatchState(ball);
+    ballHistory.Append(ball);
+    UpdatePlayerStats(ball);
+    UpdateInningsProgress(ball, isInningsComplete ? NoPlayer : matchState.striker, matchState.nonStriker);
 }
 
-void MatchEngine::SetMatchEndCallback(std::function<void(const std::string&)> callback) {
-    matchEndCallback = callback;
+ReplayCheckpoint MatchEngine::MakeCheckpoint(uint32_t ball) const {
+    ReplayCheckpoint checkpoint{};
+    checkpoint.ball = ball;
+    checkpoint.deliveryIndex = static_cast<uint32_t>(deliveryIndex);
+    checkpoint.currentOver = static_cast<uint16_t>(matchState.currentOver);
+    checkpoint.currentBall = static_cast<uint8_t>(matchState.currentBall);
+    checkpoint.currentInningsIndex = static_cast<uint8_t>(currentInningsIndex);
+    checkpoint.striker = matchState.striker;
+    checkpoint.nonStriker = matchState.nonStriker;
+    checkpoint.bowler = matchState.bowler;
+    checkpoint.target = static_cast<uint16_t>(target);
+    checkpoint.battingSide = static_cast<uint8_t>(battingSide);
+    checkpoint.nextBatterIndex = static_cast<uint8_t>(nextBatterIndex);
+    checkpoint.bowlerIndex = static_cast<uint8_t>(bowlerIndex);
+    checkpoint.isInningsComplete = isInningsComplete;
+    checkpoint.pitchWear = static_cast<uint8_t>(pitchWear);
+    checkpoint.pitchDrying = static_cast<uint8_t>(pitchDrying);
+    checkpoint.rainOversLost[0] = rainOversLost[0];
+    checkpoint.rainOversLost[1] = rainOversLost[1];
+    checkpoint.rainResourcesLost[0] = rainResourcesLost[0];
+    checkpoint.rainResourcesLost[1] = rainResourcesLost[1];
+    for (int i = 0; i < MaxInnings; ++i) {
+        checkpoint.totals[i] = ReplayTotals{
+            static_cast<uint16_t>(inningsTotals[i].runs),
+            static_cast<uint16_t>(inningsTotals[i].legalBalls),
+            static_cast<uint16_t>(inningsTotals[i].extras),
+            static_cast<uint8_t>(inningsTotals[i].wickets),
+            static_cast<uint8_t>(inningsTotals[i].battingSide)
+        };
+    }
+    return checkpoint;
 }
 
-void MatchEngine::Update(float deltaTime) {
-    // TODO: Implement real-time match updates
+void MatchEngine::ApplyCheckpoint(const ReplayCheckpoint& checkpoint) {
+    ScoreState state{};
+    for (int i = 0; i < MaxInnings; ++i) {
+        const ReplayTotals& totals = checkpoint.totals[i];
+        state.inningsTotals[i] = InningsTotals{totals.runs, totals.wickets, totals.legalBalls, totals.extras,
+                                               totals.battingSide};
+    }
+    state.rainOversLost = {checkpoint.rainOversLost[0], checkpoint.rainOversLost[1]};
+    state.rainResourcesLost = {checkpoint.rainResourcesLost[0], checkpoint.rainResourcesLost[1]};
+    state.striker = checkpoint.striker;
+    state.nonStriker = checkpoint.nonStriker;
+    state.bowler = checkpoint.bowler;
+    state.currentOver = checkpoint.currentOver;
+    state.currentBall = checkpoint.currentBall;
+    state.battingSide = checkpoint.battingSide;
+    state.nextBatterIndex = checkpoint.nextBatterIndex;
+    state.bowlerIndex = checkpoint.bowlerIndex;
+    state.target = checkpoint.target;
+    state.currentInningsIndex = checkpoint.currentInningsIndex;
+    state.deliveryIndex = static_cast<int>(checkpoint.deliveryIndex);
+    state.pitchWear = checkpoint.pitchWear;
+    state.pitchDrying = checkpoint.pitchDrying;
+    state.isInningsComplete = checkpoint.isInningsComplete != 0;
+    state.randomSeed = randomSeed;
+    state.matchIndex = matchIndex;
+    RestoreScoreState(state);
 }
 
-// Private helper methods
-BallEvent MatchEngine::SimulateBallResult() {
-    BallEvent event;
+void MatchEngine::BuildLineups() {
+    names = std::make_shared<NameTable>();
+    players.clear();
+    lineups[0] = BuildLineup(team1);
+    lineups[1] = BuildLineup(team2);
+    outcomeTablesDirty = true;
     
-    // Simple random ball result
-    std::uniform_int_distribution<> resultDist(0, 100);
-    int result = resultDist(gen);
-    
-    if (result < 30) {
-        event.result = BallResult::DOT_BALL;
-        event.runs = 0;
-        event.commentary = "Dot ball!";
-    } else if (result < 50) {
-        event.result = BallResult::SINGLE;
-        event.runs = 1;
-        event.commentary = "Single taken.";
-    } else if (result < 65) {
-        event.result = BallResult::FOUR;
-        event.runs = 4;
-        event.commentary = "FOUR! Beautiful shot!";
-    } else if (result < 75) {
-        event.result = BallResult::SIX;
-        event.runs = 6;
-        event.commentary = "SIX! Massive hit!";
-    } else if (result < 85) {
-        event.result = BallResult::WICKET;
-        event.runs = 0;
-        event.wicketType = WicketType::BOWLED;
-        event.commentary = "WICKET! Bowled!";
-    } else {
-        event.result = BallResult::WIDE;
-        event.runs = 1;
-        event.commentary = "Wide ball.";
+    // Bowlers rotate every over, so enough of them keeps everyone inside the
+    // format's per-bowler limit; part-timers come from the bottom of the order
+    size_t needed = DispatchFormat(matchType, false, [](auto format) {
+        using Format = decltype(format);
+        return Format::MaxBowlerOvers > 0 ? (Format::MaxOvers + Format::MaxBowlerOvers - 1) / Format::MaxBowlerOvers : 0;
+    });
+    for (TeamLineup& lineup : lineups) {
+        for (auto it = lineup.batting.rbegin(); it != lineup.batting.rend() && lineup.bowling.size() < needed; ++it) {
+            if (std::find(lineup.bowling.begin(), lineup.bowling.end(), *it) == lineup.bowling.end()) {
+                lineup.bowling.push_back(*it);
+            }
+        }
+    }
+}
+
+void OutcomeTable::Build(const std::array<double, BallResultCount>& weights) {
+    // Vose's alias method: split columns into under- and over-full, then let
+    // each under-full column borrow the remainder of its probability mass
+    double total = 0.0;
+    for (double weight : weights) {
+        total += weight;
     }
     
-    // Set player names
-    event.striker = matchState.striker;
-    event.nonStriker = matchState.nonStriker;
-    event.bowler = matchState.bowler;
+    std::array<double, BallResultCount> scaled;
+    std::array<int, BallResultCount> small;
+    std::array<int, BallResultCount> large;
+    int smallCount = 0;
+    int largeCount = 0;
+    for (int i = 0; i < BallResultCount; ++i) {
+        scaled[i] = total > 0.0 ? weights[i] * BallResultCount / total : 1.0;
+        if (scaled[i] < 1.0) {
+            small[smallCount++] = i;
+        } else {
+            large[largeCount++] = i;
+        }
+    }
     
-    return event;
+    auto setColumn = [this](int column, double probability, int other) {
+        threshold[column] = probability >= 1.0 ? UINT32_MAX : static_cast<uint32_t>(probability * 4294967296.0);
+        alias[column] = static_cast<uint8_t>(other);
+    };
+    
+    while (smallCount > 0 && largeCount > 0) {
+        int less = small[--smallCount];
+        int more = large[--largeCount];
+        setColumn(less, scaled[less], more);
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0) {
+            small[smallCount++] = more;
+        } else {
+            large[largeCount++] = more;
+        }
+    }
+    
+    // Leftovers are full columns up to rounding error
+    while (largeCount > 0) {
+        int column = large[--largeCount];
+        setColumn(column, 1.0, column);
+    }
+    while (smallCount > 0) {
+        int column = small[--smallCount];
+        setColumn(column, 1.0, column);
+    }
+}
+
+void MatchEngine::BuildOutcomeTables() {
+    size_t count = players.size();
+    auto tables = std::make_shared<std::vector<OutcomeTable>>(count * count, OutcomeTable{});
+    
+    // Only pairs that can actually meet need a table
+    for (int side = 0; side < 2; ++side) {
+        for (PlayerId batter : lineups[side].batting) {
+            for (PlayerId bowler : lineups[1 - side].bowling) {
+                (*tables)[batter * count + bowler].Build(
+                    CalculateOutcomeWeights(players[batter], players[bowler]));
+            }
+        }
+    }
+    outcomeTables = tables;
+    outcomeTablesDirty = false;
+}
+
+std::array<double, BallResultCount> MatchEngine::CalculateOutcomeWeights(const Player* batsman, const Player* bowler) {
+    const PlayerAttributes& bat = batsman->GetPlayerAttributes();
+    const PlayerAttributes& bowl = bowler->GetPlayerAttributes();
+    double batting = CalculateBattingSuccessRate(batsman, bowler);
+    double bowling = CalculateBowlingSuccessRate(bowler, batsman);
+    double aggression = 0.75 + bat.battingAggression / 200.0;
+    double power = 0.5 + bat.battingPower / 100.0;
+    double wayward = (150 - bowl.bowlingAccuracy) / 100.0;
+    
+    // Relative weights per ball, tuned to roughly 7.5 an over at even strength
+    std::array<double, BallResultCount> weights{};
+    weights[static_cast<int>(BallResult::DOT_BALL)] = 34.0 * (0.5 + bowling);
+    weights[static_cast<int>(BallResult::SINGLE)] = 36.0;
+    weights[static_cast<int>(BallResult::DOUBLE)] = 7.0;
+    weights[static_cast<int>(BallResult::TRIPLE)] = 0.5;
+    weights[static_cast<int>(BallResult::FOUR)] = 11.0 * (0.5 + batting) * aggression;
+    weights[static_cast<int>(BallResult::SIX)] = 4.5 * (0.5 + batting) * (0.5 + batting) * power;
+    weights[static_cast<int>(BallResult::WICKET)] = 9.0 * bowling;
+    weights[static_cast<int>(BallResult::WIDE)] = 3.0 * wayward;
+    weights[static_cast<int>(BallResult::NO_BALL)] = 0.6 * wayward;
+    weights[static_cast<int>(BallResult::BYE)] = 0.5;
+    weights[static_cast<int>(BallResult::LEG_BYE)] = 1.2;
+    weights[static_cast<int>(BallResult::RUN_OUT)] = 0.5 * (150 - bat.speed) / 100.0;
+    return weights;
+}
+
+MatchEngine::TeamLineup MatchEngine::BuildLineup(const Team* team) {
+    TeamLineup lineup;
+    if (!team) {
+        return lineup;
+    }
+    
+    // Prefer explicit orders, then the playing XI, then the first eleven of the squad
+    std::vector<Player*> eleven = team->GetPlayingXI();
+    if (eleven.empty()) {
+        for (const auto& player : team->GetSquad()) {
+            if (eleven.size() >= 11) break;
+            eleven.push_back(player.get());
+        }
+    }
+    
+    std::vector<Player*> batting = team->GetBattingOrder().empty() ? eleven : team->GetBattingOrder();
+    std::vector<Player*> bowling = team->GetBowlingOrder();
+    if (bowling.empty()) {
+        for (Player* player : eleven) {
+            if (player->GetPlayerRole() == PlayerRole::BOWLER || 
+                player->GetPlayerRole() == PlayerRole::ALL_ROUNDER) {
+                bowling.push_back(player);
+            }
+        }
+    }
+    if (bowling.empty()) {
+        // No recognised bowlers: the tail has to bowl
+        bowling.assign(eleven.rbegin(), eleven.rend());
+    }
+    
+    // Intern names so the ball log only carries ids
+    auto intern = [this](Player* player) {
+        PlayerId id = names->Intern(player->GetName());
+        if (id >= players.size()) {
+            players.resize(id + 1, nullptr);
+        }
+        players[id] = player;
+        return id;
+    };
+    for (Player* player : batting) lineup.batting.push_back(intern(player));
+    for (Player* player : bowling) lineup.bowling.push_back(intern(player));
+    return lineup;
+}
+
+BallRecord MatchEngine::MakeBallRecord() const {
+    BallRecord ball{};
+    ball.striker = matchState.striker;
+    ball.nonStriker = matchState.nonStriker;
+    ball.bowler = matchState.bowler;
+    ball.fielder = NoPlayer;
+    ball.over = static_cast<uint16_t>(matchState.currentOver);
+    ball.ball = static_cast<uint8_t>(matchState.currentBall);
+    ball.innings = static_cast<uint8_t>(currentInningsIndex);
+    ball.wicketType = static_cast<uint8_t>(WicketType::BOWLED);
+    ball.fieldingPosition = static_cast<uint8_t>(FieldingPosition::BOWLER);
+    return ball;
+}
+
+BallRecord MatchEngine::SimulateBallResult() {
+    BallRecord ball = MakeBallRecord();
+    
+    if (outcomeTablesDirty) {
+        BuildOutcomeTables();
+    }
+    
+    // Every delivery has its own stream, so replaying a match from any point
+    // draws the same numbers
+    uint64_t streamId = static_cast<uint64_t>(matchIndex) << 32 | 
+                        static_cast<uint64_t>(currentInningsIndex) << 24 | 
+                        static_cast<uint64_t>(deliveryIndex++ & 0xFFFFFF);
+    random = RandomStream(randomSeed, streamId);
+    
+    // One draw against the precomputed batter-vs-bowler table
+    const OutcomeTable& table = (*outcomeTables)[ball.striker * players.size() + ball.bowler];
+    BallResult outcome = table.Sample(random());
+    ball.result = static_cast<uint8_t>(outcome);
+    ball.runs = static_cast<uint8_t>(GetBallRuns(outcome));
+    if (outcome == BallResult::WICKET) {
+        ball.wicketType = static_cast<uint8_t>(DetermineWicketType());
+    } else if (outcome == BallResult::RUN_OUT) {
+        ball.wicketType = static_cast<uint8_t>(WicketType::RUN_OUT);
+    }
+    
+    return ball;
+}
+
+void MatchEngine::ApplyBallOutcome(BallResult outcome) {
+    if (isPaused || isMatchComplete || isInningsComplete ||
+        matchState.striker == NoPlayer || matchState.bowler == NoPlayer) {
+        return;
+    }
+    
+    BallRecord ball = MakeBallRecord();
+    ball.result = static_cast<uint8_t>(outcome);
+    ball.runs = static_cast<uint8_t>(GetBallRuns(outcome));
+    if (outcome == BallResult::RUN_OUT) {
+        ball.wicketType = static_cast<uint8_t>(WicketType::RUN_OUT);
+    }
+    deliveryIndex++;
+    UpdateMatchState(ball);
 }
 
 bool MatchEngine::SimulateWicket() {
-    std::uniform_int_distribution<> wicketDist(0, 100);
-    return wicketDist(gen) < 15; // 15% chance of wicket
+    return random.NextInt(0, 100) < 15; // 15% chance of wicket
 }
 
 WicketType MatchEngine::DetermineWicketType() {
-    std::uniform_int_distribution<> typeDist(0, 4);
-    int type = typeDist(gen);
+    // Run outs are drawn from the outcome table, so only bowler's wickets here
+    int type = random.NextInt(0, 9);
     
-    switch (type) {
-        case 0: return WicketType::BOWLED;
-        case 1: return WicketType::CAUGHT;
-        case 2: return WicketType::LBW;
-        case 3: return WicketType::RUN_OUT;
-        default: return WicketType::STUMPED;
-    }
+    if (type < 2) return WicketType::BOWLED;
+    if (type < 7) return WicketType::CAUGHT;
+    if (type < 9) return WicketType::LBW;
+    return WicketType::STUMPED;
 }
 
 int MatchEngine::SimulateRuns() {
-    std::uniform_int_distribution<> runsDist(0, 6);
-    return runsDist(gen);
+    return random.NextInt(0, 6);
 }
 
 BallResult MatchEngine::DetermineBallResult() {
-    std::uniform_int_distribution<> resultDist(0, 100);
-    int result = resultDist(gen);
+    int result = random.NextInt(0, 100);
     
     if (result < 30) return BallResult::DOT_BALL;
     if (result < 50) return BallResult::SINGLE;
@@ -319,17 +2308,77 @@ BallResult MatchEngine::DetermineBallResult() {
     return BallResult::BYE;
 }
 
-void MatchEngine::UpdateMatchState(const BallEvent& event) {
-    matchState.currentBall++;
+void MatchEngine::UpdateMatchState(const BallRecord& ball) {
+    WithInningsFormat([this, &ball](auto format) { UpdateMatchStateFor<decltype(format)>(ball); });
+}
+
+template <typename Format>
+void MatchEngine::UpdateMatchStateFor(const BallRecord& ball) {
+    InningsTotals& totals = inningsTotals[currentInningsIndex];
+    totals.runs += ball.runs;
+    if (ball.IsExtra()) {
+        totals.extras += ball.runs;
+    }
+    
+    // Wides and no-balls have to be bowled again
+    if (ball.IsLegal()) {
+        totals.legalBalls++;
+        matchState.currentBall++;
+        
+        // Multi-day pitches deteriorate at the close of each day
+        if constexpr (Format::IsTimed) {
+            if (GetMatchBallsBowled() % Format::DayBalls == 0) {
+                ApplyPitchEffects();
+            }
+        }
+    }
+    
+    if (ball.IsWicket()) {
+        totals.wickets++;
+        HandleWicket();
+    } else if (ball.IsLegal() && ball.runs % 2 == 1) {
+        SwitchStriker();
+    }
     
-    if (matchState.currentBall >= 6) {
+    bool overComplete = matchState.currentBall >= 6;
+    if (overComplete) {
         matchState.currentBall = 0;
         matchState.currentOver++;
         SwitchStriker();
+        
+        // Rotate to the next bowler in the bowling order
+        const auto& bowlers = lineups[1 - battingSide].bowling;
+        if (!bowlers.empty()) {
+            bowlerIndex = (bowlerIndex + 1) % bowlers.size();
+            matchState.bowler = bowlers[bowlerIndex];
+        }
     }
     
-    if (event.result == BallResult::WICKET) {
-        HandleWicket();
+    CheckInningsEndFor<Format>();
+    
+    // Rain can only stop play between overs
+    if (overComplete) {
+        CheckForRainFor<Format>();
+    }
+}
+
+template <typename Format>
+void MatchEngine::CheckInningsEndFor() {
+    const InningsTotals& totals = inningsTotals[currentInningsIndex];
+    bool allOut = totals.wickets >= Format::MaxWickets || matchState.striker == NoPlayer;
+    bool targetReached = target > 0 && totals.runs >= target;
+    bool oversComplete;
+    if constexpr (Format::IsTimed) {
+        // Out of time, or a declaration at the end of an over
+        oversComplete = GetMatchBallsBowled() >= Format::MatchBalls ||
+                        (matchState.currentBall == 0 && ShouldDeclare());
+    } else {
+        // Rain may have cut the innings short, or left too little for a result
+        oversComplete = matchState.currentOver >= GetAllottedOversFor<Format>(currentInningsIndex) ||
+                        IsNoResultFor<Format>();
+    }
+    if (allOut || oversComplete || targetReached) {
+        EndInnings();
     }
 }
 
@@ -338,7 +2387,13 @@ void MatchEngine::SwitchStriker() {
 }
 
 void MatchEngine::HandleWicket() {
-    // TODO: Implement wicket handling
+    // Next batter in the order replaces the dismissed striker
+    const auto& batters = lineups[battingSide].batting;
+    if (nextBatterIndex < static_cast<int>(batters.size())) {
+        matchState.striker = batters[nextBatterIndex++];
+    } else {
+        matchState.striker = NoPlayer;
+    }
 }
 
 void MatchEngine::HandleExtra() {
@@ -350,22 +2405,106 @@ void MatchEngine::CalculateRequiredRuns() {
 }
 
 void MatchEngine::DetermineMatchResult() {
-    // TODO: Implement match result determination
     isMatchComplete = true;
+    matchState.isMatchComplete = true;
     
-    if (matchEndCallback) {
-        matchEndCallback("Match completed");
+    if (matchType == MatchType::TEST) {
+        DetermineTestResult();
+    } else {
+        DetermineLimitedOversResult();
+    }
+    
+    if (fidelity == SimulationFidelity::FULL) {
+        if (eventBus) {
+            PublishEvent(MatchEventType::MATCH_END, nullptr, -1.0, false);
+        }
+        if (matchEndCallback) {
+            matchEndCallback(GetResultDescription());
+        }
+    }
+}
+
+void MatchEngine::DetermineTestResult() {
+    // The side batting now batted last
+    const InningsTotals& last = inningsTotals[currentInningsIndex];
+    int runs = GetTeamRuns(battingSide);
+    int otherRuns = GetTeamRuns(1 - battingSide);
+    bool allOut = last.wickets >= 10 || matchState.striker == NoPlayer;
+    
+    if (currentInningsIndex == 3 && target > 0 && last.runs >= target) {
+        matchState.winner = static_cast<TeamId>(battingSide);
+        matchState.winMargin = 10 - last.wickets;
+        matchState.wonByRuns = false;
+    } else if (allOut && runs == otherRuns && currentInningsIndex == 3) {
+        matchState.winner = NoTeam;
+        matchState.isTie = true;
+    } else if (allOut && runs < otherRuns && currentInningsIndex >= 2) {
+        matchState.winner = static_cast<TeamId>(1 - battingSide);
+        matchState.winMargin = otherRuns - runs;
+        matchState.wonByRuns = true;
+        matchState.wonByInnings = currentInningsIndex == 2;
+    } else {
+        matchState.winner = NoTeam;
+        matchState.isDraw = true;
+    }
+}
+
+void MatchEngine::DetermineLimitedOversResult() {
+    if (currentInningsIndex < 2 && WithInningsFormat([this](auto format) { return IsNoResultFor<decltype(format)>(); })) {
+        matchState.winner = NoTeam;
+        matchState.isNoResult = true;
+        return;
+    }
+    
+    // A super over, when one was played, decides the match on its own. The
+    // chase is measured against its target, which rain may have revised.
+    int first = currentInningsIndex >= 2 ? 2 : 0;
+    const InningsTotals& batFirst = inningsTotals[first];
+    const InningsTotals& chase = inningsTotals[first + 1];
+    int wickets = first == 2 ? SuperOverPolicy::MaxWickets : 10;
+    int par = target - 1;
+    
+    if (par > chase.runs) {
+        matchState.winner = static_cast<TeamId>(batFirst.battingSide);
+        matchState.winMargin = par - chase.runs;
+        matchState.wonByRuns = true;
+    } else if (chase.runs > par) {
+        matchState.winner = static_cast<TeamId>(chase.battingSide);
+        matchState.winMargin = wickets - chase.wickets;
+        matchState.wonByRuns = false;
+    } else {
+        matchState.winner = NoTeam;
+        matchState.isTie = true;
     }
+    matchState.wonBySuperOver = first == 2 && !matchState.isTie;
 }
 
 double MatchEngine::CalculateBattingSuccessRate(const Player* batsman, const Player* bowler) {
-    // TODO: Implement batting success rate calculation
-    return 0.5;
+    // 0.5 at even strength, harder on difficult pitches
+    double edge = (batsman->GetBattingRating() - bowler->GetBowlingRating()) / 100.0;
+    double rate = 0.5 + edge * 0.5 - (GetPitchDifficulty() - 5.0) * 0.02;
+    return std::max(0.1, std::min(0.9, rate));
 }
 
 double MatchEngine::CalculateBowlingSuccessRate(const Player* bowler, const Player* batsman) {
-    // TODO: Implement bowling success rate calculation
-    return 0.3;
+    const PlayerAttributes& attributes = bowler->GetPlayerAttributes();
+    double edge = (bowler->GetBowlingRating() - batsman->GetBattingRating()) / 100.0;
+    
+    // Spinners like worn, turning pitches; seamers like grass and cloud cover
+    PitchConditions pitch = GetMatchPitch();
+    double conditions = 0.0;
+    if (attributes.bowlingSpin > attributes.bowlingPace) {
+        conditions += (pitch.wear - 5) * 0.02;
+        conditions += pitch.isSpinning ? 0.05 : 0.0;
+    } else {
+        conditions += (pitch.grass - 5) * 0.015;
+        conditions += pitch.isSeaming ? 0.05 : 0.0;
+        conditions += weatherConditions.isOvercast ? 0.03 : 0.0;
+        conditions += (weatherConditions.humidity - 60) / 1000.0;
+    }
+    
+    double rate = 0.5 + edge * 0.5 + conditions;
+    return std::max(0.1, std::min(0.9, rate));
 }
 
 double MatchEngine::CalculateFieldingSuccessRate(const Player* fielder) {
@@ -378,10 +2517,57 @@ void MatchEngine::ApplyWeatherEffects() {
 }
 
 void MatchEngine::ApplyPitchEffects() {
-    // TODO: Implement pitch effects
+    // A day's wear and drying as the venue models it; outcome tables pick
+    // them up on the next ball
+    PitchConditions current = GetMatchPitch();
+    PitchCharacteristics pitch{};
+    pitch.type = venue ? venue->GetPitchCharacteristics().type : PitchType::BALANCED;
+    pitch.hardness = current.hardness;
+    pitch.moisture = current.moisture;
+    pitch.grass = current.grass;
+    pitch.wear = current.wear;
+    if (venue) {
+        venue->UpdatePitchWear(pitch);
+    } else {
+        pitch.wear = std::min(10, pitch.wear + 1);
+    }
+    
+    int wear = std::max(pitchWear, pitch.wear - pitchConditions.wear);
+    int drying = std::max(pitchDrying, pitchConditions.moisture - pitch.moisture);
+    if (wear != pitchWear || drying != pitchDrying) {
+        pitchWear = wear;
+        pitchDrying = drying;
+        outcomeTablesDirty = true;
+    }
+}
+
+PitchConditions MatchEngine::GetMatchPitch() const {
+    PitchConditions pitch = pitchConditions;
+    if (pitchWear == 0 && pitchDrying == 0) {
+        return pitch;
+    }
+    
+    // Once the pitch has changed, spin and seam follow from what it is now
+    PitchCharacteristics worn{};
+    worn.type = venue ? venue->GetPitchCharacteristics().type : PitchType::BALANCED;
+    worn.hardness = pitch.hardness;
+    worn.moisture = std::max(1, pitch.moisture - pitchDrying);
+    worn.grass = pitch.grass;
+    worn.wear = std::min(10, pitch.wear + pitchWear);
+    Venue::CalculatePitchEffects(worn);
+    pitch.moisture = worn.moisture;
+    pitch.wear = worn.wear;
+    pitch.isSpinning = worn.isSpinning;
+    pitch.isSeaming = worn.isSeaming;
+    pitch.isBouncy = worn.isBouncy;
+    return pitch;
 }
 
 double MatchEngine::GetPitchDifficulty() {
-    // TODO: Implement pitch difficulty calculation
-    return 5.0;
-} 
\ No newline at end of file
+    PitchConditions pitch = GetMatchPitch();
+    double difficulty = (pitch.grass + pitch.moisture + pitch.wear) / 3.0;
+    if (pitch.isSpinning || pitch.isSeaming) {
+        difficulty += 1.0;
+    }
+    return std::max(1.0, std::min(10.0, difficulty));
+}
@@ -0,0 +1,189 @@
+#include "MatchEventBus.h"
+#include <algorithm>
+
+struct MatchEventBus::Subscriber {
+    SubscriberId id;
+    Handler handler;
+    bool backPressure;
+    size_t maxBatch;
+    std::vector<MatchEvent> ring;
+    uint64_t mask;
+
+    // Producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<uint64_t> tail{0}; // next slot to write
+    alignas(64) std::atomic<uint64_t> head{0}; // next slot to read
+    alignas(64) std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> handled{0};
+    std::atomic<bool> sleeping{false};
+
+    std::mutex mutex;
+    std::condition_variable dataReady;
+    std::condition_variable spaceReady;
+    std::condition_variable drained;
+    bool stopping = false;
+    std::thread worker;
+};
+
+MatchEventBus::MatchEventBus()
+    : nextId(1)
+    , nextSequence(0)
+{
+}
+
+MatchEventBus::~MatchEventBus() {
+    std::vector<std::shared_ptr<Subscriber>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        remaining.swap(subscribers);
+    }
+    for (auto& subscriber : remaining) {
+        Stop(*subscriber);
+    }
+}
+
+MatchEventBus::SubscriberId MatchEventBus::Subscribe(Handler handler, SubscriberOptions options) {
+    size_t capacity = 1;
+    while (capacity < std::max<size_t>(options.capacity, 2)) {
+        capacity <<= 1;
+    }
+
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->handler = std::move(handler);
+    subscriber->backPressure = options.backPressure;
+    subscriber->maxBatch = std::max<size_t>(options.maxBatch, 1);
+    subscriber->ring.resize(capacity);
+    subscriber->mask = capacity - 1;
+    subscriber->worker = std::thread(&MatchEventBus::Run, subscriber);
+
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    subscriber->id = nextId++;
+    subscribers.push_back(subscriber);
+    return subscriber->id;
+}
+
+void MatchEventBus::Unsubscribe(SubscriberId id) {
+    std::shared_ptr<Subscriber> removed;
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        auto it = std::find_if(subscribers.begin(), subscribers.end(),
+                               [id](const std::shared_ptr<Subscriber>& s) { return s->id == id; });
+        if (it == subscribers.end()) {
+            return;
+        }
+        removed = *it;
+        subscribers.erase(it);
+    }
+    Stop(*removed);
+}
+
+void MatchEventBus::Publish(const MatchEvent& event) {
+    // Handlers may subscribe or unsubscribe while a back-pressure wait is on,
+    // so the list is copied and the lock released before delivering
+    MatchEvent stamped = event;
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        stamped.sequence = nextSequence++;
+        publishing.assign(subscribers.begin(), subscribers.end()); // keeps its capacity
+    }
+
+    for (auto& subscriber : publishing) {
+        Subscriber& s = *subscriber;
+        uint64_t tail = s.tail.load(std::memory_order_relaxed);
+        if (tail - s.head.load(std::memory_order_acquire) > s.mask) {
+            if (!s.backPressure) {
+                s.dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::unique_lock<std::mutex> wait(s.mutex);
+            s.spaceReady.wait(wait, [&s, tail] { return tail - s.head.load() <= s.mask || s.stopping; });
+        }
+
+        s.ring[tail & s.mask] = stamped;
+        s.tail.store(tail + 1);
+
+        // Only take the lock when the consumer has gone to sleep
+        if (s.sleeping.load()) {
+            std::lock_guard<std::mutex> wake(s.mutex);
+            s.dataReady.notify_one();
+        }
+    }
+    publishing.clear();
+}
+
+void MatchEventBus::Flush() {
+    std::vector<std::shared_ptr<Subscriber>> current;
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        current = subscribers;
+    }
+    for (auto& subscriber : current) {
+        Subscriber& s = *subscriber;
+        uint64_t queued = s.tail.load();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        s.drained.wait(lock, [&s, queued] { return s.handled.load() >= queued || s.stopping; });
+    }
+}
+
+uint64_t MatchEventBus::GetDroppedCount(SubscriberId id) const {
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    for (const auto& subscriber : subscribers) {
+        if (subscriber->id == id) {
+            return subscriber->dropped.load();
+        }
+    }
+    return 0;
+}
+
+void MatchEventBus::Run(std::shared_ptr<Subscriber> subscriber) {
+    Subscriber& s = *subscriber;
+    std::vector<MatchEvent> batch;
+    batch.reserve(s.maxBatch);
+
+    while (true) {
+        uint64_t head = s.head.load(std::memory_order_relaxed);
+        uint64_t available = s.tail.load() - head;
+        if (available == 0) {
+            std::unique_lock<std::mutex> lock(s.mutex);
+            s.sleeping.store(true);
+            s.dataReady.wait(lock, [&s, head] { return s.tail.load() != head || s.stopping; });
+            s.sleeping.store(false);
+            if (s.tail.load() == head && s.stopping) {
+                return;
+            }
+            continue;
+        }
+
+        // Copy the batch out so the producer can reuse the slots at once
+        size_t count = static_cast<size_t>(std::min<uint64_t>(available, s.maxBatch));
+        batch.clear();
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(s.ring[(head + i) & s.mask]);
+        }
+        s.head.store(head + count);
+
+        s.handler(batch.data(), batch.size());
+        s.handled.fetch_add(count);
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.spaceReady.notify_one();
+        s.drained.notify_all();
+    }
+}
+
+void MatchEventBus::Stop(Subscriber& s) {
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.stopping = true;
+    }
+    s.dataReady.notify_one();
+    s.spaceReady.notify_one();
+    s.drained.notify_all();
+
+    // A handler unsubscribing itself cannot wait for its own thread; the
+    // thread holds the subscriber until it has drained the ring
+    if (s.worker.get_id() == std::this_thread::get_id()) {
+        s.worker.detach();
+    } else {
+        s.worker.join();
+    }
+}
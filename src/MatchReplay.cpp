@@ -0,0 +1,135 @@
+#include "MatchReplay.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char ReplayMagic[4] = {'C', 'R', 'P', 'L'};
+
+// Runs so far in the over, player lines and every innings' progress
+std::streamoff GetStateBlockSize(uint32_t lineCount) {
+    return sizeof(uint32_t) + static_cast<std::streamoff>(lineCount) * sizeof(PlayerMatchStats) +
+           MatchEngine::MaxInnings * sizeof(InningsProgress);
+}
+
+} // namespace
+
+bool MatchReplay::Write(const std::string& path, const ReplayHeader& header, const BallLog& balls,
+                        const std::vector<ReplayCheckpoint>& checkpoints,
+                        const std::vector<RainInterruption>& rain,
+                        const std::vector<ReplayCheckpointState>& states) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    ReplayHeader written = header;
+    std::memcpy(written.magic, ReplayMagic, sizeof(ReplayMagic));
+    written.version = Version;
+    written.ballCount = static_cast<uint32_t>(balls.Size());
+    written.checkpointCount = static_cast<uint32_t>(checkpoints.size());
+    out.write(reinterpret_cast<const char*>(&written), sizeof(written));
+
+    // Records go out a chunk at a time; chunks are contiguous in memory
+    size_t index = 0;
+    while (index < balls.Size()) {
+        size_t count = std::min(BallLog::ChunkSize - index % BallLog::ChunkSize, balls.Size() - index);
+        out.write(reinterpret_cast<const char*>(&balls[index]), count * sizeof(BallRecord));
+        index += count;
+    }
+
+    if (!checkpoints.empty()) {
+        out.write(reinterpret_cast<const char*>(checkpoints.data()), checkpoints.size() * sizeof(ReplayCheckpoint));
+    }
+
+    uint32_t rainCount = static_cast<uint32_t>(rain.size());
+    out.write(reinterpret_cast<const char*>(&rainCount), sizeof(rainCount));
+    if (!rain.empty()) {
+        out.write(reinterpret_cast<const char*>(rain.data()), rain.size() * sizeof(RainInterruption));
+    }
+
+    // Every block has the same number of lines, so each can be found by index
+    uint32_t lineCount = states.empty() ? 0 : static_cast<uint32_t>(states.front().playerStats.size());
+    out.write(reinterpret_cast<const char*>(&lineCount), sizeof(lineCount));
+    for (const ReplayCheckpointState& state : states) {
+        if (state.playerStats.size() != lineCount) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&state.overRunsCharged), sizeof(state.overRunsCharged));
+        out.write(reinterpret_cast<const char*>(state.playerStats.data()), lineCount * sizeof(PlayerMatchStats));
+        out.write(reinterpret_cast<const char*>(state.inningsProgress.data()),
+                  state.inningsProgress.size() * sizeof(InningsProgress));
+    }
+    return static_cast<bool>(out);
+}
+
+bool MatchReplay::Open(const std::string& replayPath) {
+    file.close();
+    checkpoints.clear();
+    rain.clear();
+    header = ReplayHeader{};
+    stateLineCount = 0;
+    path = replayPath;
+
+    file.open(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, ReplayMagic, sizeof(ReplayMagic)) != 0 || header.version != Version) {
+        file.close();
+        return false;
+    }
+
+    checkpoints.resize(header.checkpointCount);
+    file.seekg(sizeof(ReplayHeader) + static_cast<std::streamoff>(header.ballCount) * sizeof(BallRecord));
+    file.read(reinterpret_cast<char*>(checkpoints.data()), checkpoints.size() * sizeof(ReplayCheckpoint));
+    uint32_t rainCount = 0;
+    file.read(reinterpret_cast<char*>(&rainCount), sizeof(rainCount));
+    rain.resize(file ? rainCount : 0);
+    file.read(reinterpret_cast<char*>(rain.data()), rain.size() * sizeof(RainInterruption));
+    file.read(reinterpret_cast<char*>(&stateLineCount), sizeof(stateLineCount));
+    statesOffset = file.tellg();
+    if (!file) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+const ReplayCheckpoint* MatchReplay::FindCheckpoint(uint32_t ball) const {
+    // Checkpoints are written in ball order
+    auto next = std::upper_bound(checkpoints.begin(), checkpoints.end(), ball,
+        [](uint32_t value, const ReplayCheckpoint& checkpoint) { return value < checkpoint.ball; });
+    return next == checkpoints.begin() ? nullptr : &*(next - 1);
+}
+
+bool MatchReplay::ReadCheckpointState(const ReplayCheckpoint& checkpoint, ReplayCheckpointState& out) {
+    if (!file.is_open() || checkpoints.empty() ||
+        &checkpoint < checkpoints.data() || &checkpoint > &checkpoints.back()) {
+        return false;
+    }
+
+    std::streamoff index = &checkpoint - checkpoints.data();
+    out.playerStats.resize(stateLineCount);
+    file.clear();
+    file.seekg(statesOffset + index * GetStateBlockSize(stateLineCount));
+    file.read(reinterpret_cast<char*>(&out.overRunsCharged), sizeof(out.overRunsCharged));
+    file.read(reinterpret_cast<char*>(out.playerStats.data()), stateLineCount * sizeof(PlayerMatchStats));
+    file.read(reinterpret_cast<char*>(out.inningsProgress.data()), out.inningsProgress.size() * sizeof(InningsProgress));
+    return static_cast<bool>(file);
+}
+
+bool MatchReplay::ReadBalls(uint32_t first, uint32_t count, std::vector<BallRecord>& out) {
+    out.clear();
+    if (!file.is_open() || first > header.ballCount || count > header.ballCount - first) {
+        return false;
+    }
+
+    out.resize(count);
+    file.clear();
+    file.seekg(sizeof(ReplayHeader) + static_cast<std::streamoff>(first) * sizeof(BallRecord));
+    file.read(reinterpret_cast<char*>(out.data()), count * sizeof(BallRecord));
+    return static_cast<bool>(file);
+}
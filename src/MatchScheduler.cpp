@@ -0,0 +1,45 @@
+#include "MatchScheduler.h"
+
+size_t MatchScheduler::Add(MatchEngine* match) {
+    size_t slot = matches.size();
+    matches.push_back(match);
+    if (!match->IsMatchComplete()) {
+        active.push_back(static_cast<uint32_t>(slot));
+    }
+    return slot;
+}
+
+void MatchScheduler::Clear() {
+    matches.clear();
+    active.clear();
+    advancedLastStep = 0;
+}
+
+size_t MatchScheduler::Step(MatchBoundary until) {
+    // Finished matches drop out as we go, keeping the rest in slot order
+    size_t kept = 0;
+    advancedLastStep = 0;
+    for (uint32_t slot : active) {
+        MatchEngine& match = *matches[slot];
+        MatchBoundary reached = match.Advance(until);
+        if (reached != MatchBoundary::NONE) {
+            advancedLastStep++;
+            if (stepCallback) {
+                stepCallback(slot, match, reached);
+            }
+        }
+        if (!match.IsMatchComplete()) {
+            active[kept++] = slot;
+        }
+    }
+    active.resize(kept);
+    return kept;
+}
+
+void MatchScheduler::Run(MatchBoundary until) {
+    // Stop rather than spin once only paused matches are left
+    size_t remaining = Step(until);
+    while (remaining > 0 && advancedLastStep > 0) {
+        remaining = Step(until);
+    }
+}
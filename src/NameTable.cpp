@@ -0,0 +1,39 @@
+#include "NameTable.h"
+#include <stdexcept>
+
+NameTable::NameTable() {
+}
+
+NameTable::~NameTable() {
+}
+
+uint16_t NameTable::Intern(const std::string& name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    
+    if (names.size() >= NoPlayer) {
+        throw std::length_error("NameTable: too many names to intern");
+    }
+    
+    uint16_t id = static_cast<uint16_t>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+uint16_t NameTable::Find(const std::string& name) const {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : NoPlayer;
+}
+
+const std::string& NameTable::GetName(uint16_t id) const {
+    static const std::string empty;
+    return id < names.size() ? names[id] : empty;
+}
+
+void NameTable::Clear() {
+    names.clear();
+    ids.clear();
+}
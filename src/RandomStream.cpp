@@ -0,0 +1,55 @@
+#include "RandomStream.h"
+#include <atomic>
+#include <mutex>
+#include <random>
+
+namespace {
+
+std::once_flag seedOnce;
+std::atomic<uint64_t> baseSeed{0};
+std::atomic<bool> seedFixed{false};
+
+void EnsureSeed() {
+    std::call_once(seedOnce, [] {
+        if (!seedFixed.load()) {
+            std::random_device device;
+            baseSeed = (static_cast<uint64_t>(device()) << 32) | device();
+        }
+    });
+}
+
+} // namespace
+
+void RandomService::SetSeed(uint64_t seed) {
+    seedFixed = true;
+    baseSeed = seed;
+}
+
+uint64_t RandomService::GetSeed() {
+    EnsureSeed();
+    return baseSeed.load();
+}
+
+uint64_t RandomService::GetDomainKey(RandomDomain domain) {
+    return Mix(GetSeed() ^ (static_cast<uint64_t>(domain) + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+RandomStream RandomService::GetStream(RandomDomain domain, uint64_t stream) {
+    return RandomStream(GetDomainKey(domain), stream);
+}
+
+uint64_t RandomService::HashName(const std::string& name) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+uint64_t RandomService::Mix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
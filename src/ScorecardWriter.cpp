@@ -0,0 +1,506 @@
+#include "ScorecardWriter.h"
+#include <charconv>
+#include <string_view>
+
+namespace {
+
+void AppendInt(std::string& out, long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+void AppendFixed(std::string& out, double value, int precision) {
+    char digits[48];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    out.append(digits, result.ptr);
+}
+
+// Column helpers for the text card: text is cut or padded to width
+void AppendLeft(std::string& out, std::string_view text, size_t width) {
+    text = text.substr(0, width);
+    out.append(text);
+    out.append(width - text.size(), ' ');
+}
+
+void AppendRight(std::string& out, std::string_view text, size_t width) {
+    out.append(text.size() < width ? width - text.size() : 0, ' ');
+    out.append(text);
+}
+
+void AppendRightInt(std::string& out, long long value, size_t width) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    AppendRight(out, std::string_view(digits, result.ptr - digits), width);
+}
+
+void AppendRightFixed(std::string& out, double value, int precision, size_t width) {
+    char digits[48];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    AppendRight(out, std::string_view(digits, result.ptr - digits), width);
+}
+
+// "12.3" for twelve overs and three balls
+void AppendOvers(std::string& out, int legalBalls) {
+    AppendInt(out, legalBalls / 6);
+    out += '.';
+    AppendInt(out, legalBalls % 6);
+}
+
+void AppendRightOvers(std::string& out, int legalBalls, size_t width) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), legalBalls / 6);
+    *result.ptr++ = '.';
+    result = std::to_chars(result.ptr, digits + sizeof(digits), legalBalls % 6);
+    AppendRight(out, std::string_view(digits, result.ptr - digits), width);
+}
+
+void AppendJsonString(std::string& out, std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += "\\u00";
+            out += hex[(c >> 4) & 0xF];
+            out += hex[c & 0xF];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+bool NeedsCsvQuotes(std::string_view text) {
+    return text.find_first_of(",\"\n") != std::string_view::npos;
+}
+
+void AppendCsvField(std::string& out, std::string_view text) {
+    if (!NeedsCsvQuotes(text)) {
+        out.append(text);
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') {
+            out += '"';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+// Escape text already appended from start on, for text written by helpers
+// that do not know the output format
+void EscapeFrom(std::string& out, size_t start, std::string_view special, char escape) {
+    for (size_t c = start; c < out.size(); ++c) {
+        if (special.find(out[c]) != std::string_view::npos) {
+            out.insert(out.begin() + c++, escape);
+        }
+    }
+}
+
+const char* GetFormatName(MatchType type) {
+    switch (type) {
+        case MatchType::T20: return "T20";
+        case MatchType::ODI: return "ODI";
+        default: return "Test";
+    }
+}
+
+// A batter came in during the innings if they were part of any partnership
+bool HasBatted(const InningsProgress& progress, PlayerId id) {
+    for (int i = 0; i < progress.partnershipCount; ++i) {
+        const Partnership& partnership = progress.partnerships[i];
+        if (partnership.batters[0].id == id || partnership.batters[1].id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// "lbw b Smith", "run out", "not out". Fielders are not tracked, so catches
+// and stumpings read "caught b Smith" and "stumped b Smith".
+void AppendDismissal(std::string& out, const MatchEngine& engine, const PlayerMatchStats& line) {
+    if (!line.dismissed) {
+        out += "not out";
+        return;
+    }
+    switch (static_cast<WicketType>(line.howOut)) {
+        case WicketType::RUN_OUT: out += "run out"; return;
+        case WicketType::CAUGHT: out += "caught b "; break;
+        case WicketType::LBW: out += "lbw b "; break;
+        case WicketType::STUMPED: out += "stumped b "; break;
+        case WicketType::HIT_WICKET: out += "hit wicket b "; break;
+        default: out += "b "; break;
+    }
+    if (line.dismissedBy != NoPlayer) {
+        out += engine.GetPlayerName(line.dismissedBy);
+    }
+}
+
+// "India innings", "India 2nd innings" in Tests, "India super over"
+void AppendInningsName(std::string& out, const MatchEngine& engine, int inningsIndex) {
+    int side = engine.GetInningsTotals(inningsIndex).battingSide;
+    out += engine.GetTeamName(static_cast<TeamId>(side));
+    if (engine.GetMatchState().matchType != MatchType::TEST) {
+        out += inningsIndex >= 2 ? " super over" : " innings";
+        return;
+    }
+    int teamInnings = 0;
+    for (int i = 0; i <= inningsIndex; ++i) {
+        teamInnings += engine.GetInningsTotals(i).battingSide == side;
+    }
+    out += teamInnings == 1 ? " 1st innings" : " 2nd innings";
+}
+
+int GetInningsCount(const MatchEngine& engine) {
+    return static_cast<int>(engine.GetInnings().size());
+}
+
+} // namespace
+
+void ScorecardWriter::Write(const MatchEngine& engine, ScorecardFormat format, std::string& out) {
+    switch (format) {
+        case ScorecardFormat::TEXT: WriteText(engine, out); break;
+        case ScorecardFormat::JSON: WriteJson(engine, out); break;
+        case ScorecardFormat::CSV: WriteCsv(engine, out); break;
+    }
+}
+
+void ScorecardWriter::WriteResult(const MatchEngine& engine, std::string& out) {
+    const MatchState& state = engine.GetMatchState();
+    if (!state.isMatchComplete) {
+        out += "Match in progress";
+        return;
+    }
+    if (state.isTie) {
+        out += "Match tied";
+        return;
+    }
+    if (state.isDraw) {
+        out += "Match drawn";
+        return;
+    }
+    if (state.isNoResult) {
+        out += "No result";
+        return;
+    }
+    out += engine.GetTeamName(state.winner);
+    if (state.wonBySuperOver) {
+        out += " won the super over";
+        return;
+    }
+    out += state.wonByInnings ? " won by an innings and " : " won by ";
+    AppendInt(out, state.winMargin);
+    out += state.wonByRuns || state.wonByInnings ? " run" : " wicket";
+    if (state.winMargin != 1) {
+        out += 's';
+    }
+    if (engine.IsRainAffected()) {
+        out += " (revised target)";
+    }
+}
+
+void ScorecardWriter::WriteText(const MatchEngine& engine, std::string& out) {
+    const MatchState& state = engine.GetMatchState();
+    out += "=== MATCH SCORECARD ===\n";
+    out += engine.GetTeamName(0);
+    out += " vs ";
+    out += engine.GetTeamName(1);
+    out += '\n';
+    if (const Venue* venue = engine.GetVenue()) {
+        out += "Venue: ";
+        out += venue->GetName();
+        out += '\n';
+    }
+    out += "Format: ";
+    out += GetFormatName(state.matchType);
+    out += '\n';
+    WriteResult(engine, out);
+    out += '\n';
+
+    for (int i = 0; i < GetInningsCount(engine); ++i) {
+        const InningsTotals& totals = engine.GetInningsTotals(i);
+        const InningsProgress& progress = engine.GetInningsProgress(i);
+        int side = totals.battingSide;
+
+        out += '\n';
+        AppendInningsName(out, engine, i);
+        out += '\n';
+        AppendLeft(out, "Batter", 22);
+        AppendLeft(out, "", 26);
+        out += "    R    B   4s   6s      SR\n";
+
+        for (PlayerId id : engine.GetBattingOrder(side)) {
+            if (!HasBatted(progress, id)) {
+                continue;
+            }
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            AppendLeft(out, engine.GetPlayerName(id), 22);
+            size_t dismissal = out.size();
+            AppendDismissal(out, engine, line);
+            if (out.size() - dismissal > 26) {
+                out.resize(dismissal + 26);
+            }
+            out.append(26 - (out.size() - dismissal), ' ');
+            AppendRightInt(out, line.runs, 5);
+            AppendRightInt(out, line.ballsFaced, 5);
+            AppendRightInt(out, line.fours, 5);
+            AppendRightInt(out, line.sixes, 5);
+            AppendRightFixed(out, line.GetStrikeRate(), 2, 8);
+            out += '\n';
+        }
+
+        out += "Extras: ";
+        AppendInt(out, totals.extras);
+        out += "\nTotal: ";
+        AppendInt(out, totals.runs);
+        out += '/';
+        AppendInt(out, totals.wickets);
+        out += " (";
+        AppendOvers(out, totals.legalBalls);
+        out += " ov, RR ";
+        AppendFixed(out, totals.legalBalls > 0 ? totals.runs * 6.0 / totals.legalBalls : 0.0, 2);
+        out += ")\n";
+
+        bool anyDidNotBat = false;
+        for (PlayerId id : engine.GetBattingOrder(side)) {
+            if (!HasBatted(progress, id)) {
+                out += anyDidNotBat ? ", " : "Did not bat: ";
+                out += engine.GetPlayerName(id);
+                anyDidNotBat = true;
+            }
+        }
+        if (anyDidNotBat) {
+            out += '\n';
+        }
+
+        if (progress.wicketCount > 0) {
+            out += "Fall of wickets:";
+            for (int w = 0; w < progress.wicketCount; ++w) {
+                const FallOfWicket& fall = progress.fallOfWickets[w];
+                out += w > 0 ? ", " : " ";
+                AppendInt(out, w + 1);
+                out += '-';
+                AppendInt(out, fall.runs);
+                out += " (";
+                out += engine.GetPlayerName(fall.batter);
+                out += ", ";
+                AppendOvers(out, fall.legalBalls);
+                out += " ov)";
+            }
+            out += '\n';
+        }
+
+        AppendLeft(out, "Bowler", 22);
+        out += "     O    M    R    W    Econ\n";
+        for (PlayerId id : engine.GetBowlingOrder(1 - side)) {
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            if (line.ballsBowled == 0 && line.runsConceded == 0) {
+                continue;
+            }
+            AppendLeft(out, engine.GetPlayerName(id), 22);
+            AppendRightOvers(out, line.ballsBowled, 6);
+            AppendRightInt(out, line.maidens, 5);
+            AppendRightInt(out, line.runsConceded, 5);
+            AppendRightInt(out, line.wickets, 5);
+            AppendRightFixed(out, line.GetEconomy(), 2, 8);
+            out += '\n';
+        }
+    }
+
+    // The pair at the crease while the match is on
+    const InningsProgress& current = engine.GetCurrentInningsProgress();
+    if (!state.isMatchComplete && current.HasCurrentPartnership()) {
+        const Partnership& partnership = current.GetCurrentPartnership();
+        out += "\nPartnership: ";
+        AppendInt(out, partnership.runs);
+        out += " (";
+        AppendInt(out, partnership.legalBalls);
+        out += ')';
+        for (const PartnershipBatter& batter : partnership.batters) {
+            out += ' ';
+            out += engine.GetPlayerName(batter.id);
+            out += ' ';
+            AppendInt(out, batter.inningsRuns);
+            out += "* (";
+            AppendInt(out, batter.inningsBalls);
+            out += ')';
+        }
+        out += '\n';
+    }
+}
+
+void ScorecardWriter::WriteJson(const MatchEngine& engine, std::string& out) {
+    const MatchState& state = engine.GetMatchState();
+    out += "{\"teams\":[";
+    AppendJsonString(out, engine.GetTeamName(0));
+    out += ',';
+    AppendJsonString(out, engine.GetTeamName(1));
+    out += "],\"venue\":";
+    AppendJsonString(out, engine.GetVenue() ? std::string_view(engine.GetVenue()->GetName()) : std::string_view());
+    out += ",\"format\":\"";
+    out += GetFormatName(state.matchType);
+    out += "\",\"complete\":";
+    out += state.isMatchComplete ? "true" : "false";
+    out += ",\"result\":\"";
+    // Team names in the result need escaping like any other string
+    size_t result = out.size();
+    WriteResult(engine, out);
+    EscapeFrom(out, result, "\"\\", '\\');
+    out += "\",\"innings\":[";
+
+    for (int i = 0; i < GetInningsCount(engine); ++i) {
+        const InningsTotals& totals = engine.GetInningsTotals(i);
+        const InningsProgress& progress = engine.GetInningsProgress(i);
+        int side = totals.battingSide;
+
+        out += i > 0 ? ",{\"team\":" : "{\"team\":";
+        AppendJsonString(out, engine.GetTeamName(static_cast<TeamId>(side)));
+        out += ",\"runs\":";
+        AppendInt(out, totals.runs);
+        out += ",\"wickets\":";
+        AppendInt(out, totals.wickets);
+        out += ",\"overs\":\"";
+        AppendOvers(out, totals.legalBalls);
+        out += "\",\"extras\":";
+        AppendInt(out, totals.extras);
+
+        out += ",\"batting\":[";
+        bool first = true;
+        for (PlayerId id : engine.GetBattingOrder(side)) {
+            if (!HasBatted(progress, id)) {
+                continue;
+            }
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            out += first ? "{\"name\":" : ",{\"name\":";
+            first = false;
+            AppendJsonString(out, engine.GetPlayerName(id));
+            out += ",\"dismissal\":\"";
+            size_t dismissal = out.size();
+            AppendDismissal(out, engine, line);
+            EscapeFrom(out, dismissal, "\"\\", '\\');
+            out += "\",\"runs\":";
+            AppendInt(out, line.runs);
+            out += ",\"balls\":";
+            AppendInt(out, line.ballsFaced);
+            out += ",\"fours\":";
+            AppendInt(out, line.fours);
+            out += ",\"sixes\":";
+            AppendInt(out, line.sixes);
+            out += ",\"strikeRate\":";
+            AppendFixed(out, line.GetStrikeRate(), 2);
+            out += '}';
+        }
+
+        out += "],\"bowling\":[";
+        first = true;
+        for (PlayerId id : engine.GetBowlingOrder(1 - side)) {
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            if (line.ballsBowled == 0 && line.runsConceded == 0) {
+                continue;
+            }
+            out += first ? "{\"name\":" : ",{\"name\":";
+            first = false;
+            AppendJsonString(out, engine.GetPlayerName(id));
+            out += ",\"overs\":\"";
+            AppendOvers(out, line.ballsBowled);
+            out += "\",\"maidens\":";
+            AppendInt(out, line.maidens);
+            out += ",\"runs\":";
+            AppendInt(out, line.runsConceded);
+            out += ",\"wickets\":";
+            AppendInt(out, line.wickets);
+            out += ",\"economy\":";
+            AppendFixed(out, line.GetEconomy(), 2);
+            out += '}';
+        }
+
+        out += "],\"fallOfWickets\":[";
+        for (int w = 0; w < progress.wicketCount; ++w) {
+            const FallOfWicket& fall = progress.fallOfWickets[w];
+            out += w > 0 ? ",{\"batter\":" : "{\"batter\":";
+            AppendJsonString(out, engine.GetPlayerName(fall.batter));
+            out += ",\"runs\":";
+            AppendInt(out, fall.runs);
+            out += ",\"overs\":\"";
+            AppendOvers(out, fall.legalBalls);
+            out += "\"}";
+        }
+        out += "]}";
+    }
+    out += "]}\n";
+}
+
+void ScorecardWriter::WriteCsv(const MatchEngine& engine, std::string& out) {
+    // One row per batting or bowling line; the other card's columns are empty
+    out += "innings,team,card,player,dismissal,runs,balls,fours,sixes,strike_rate,overs,maidens,conceded,wickets,economy\n";
+    for (int i = 0; i < GetInningsCount(engine); ++i) {
+        int side = engine.GetInningsTotals(i).battingSide;
+        const InningsProgress& progress = engine.GetInningsProgress(i);
+        const std::string& team = engine.GetTeamName(static_cast<TeamId>(side));
+        const std::string& fielding = engine.GetTeamName(static_cast<TeamId>(1 - side));
+
+        for (PlayerId id : engine.GetBattingOrder(side)) {
+            if (!HasBatted(progress, id)) {
+                continue;
+            }
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            AppendInt(out, i + 1);
+            out += ',';
+            AppendCsvField(out, team);
+            out += ",batting,";
+            AppendCsvField(out, engine.GetPlayerName(id));
+            out += ',';
+            // The bowler's name decides whether the dismissal needs quoting
+            bool quote = line.dismissed && line.dismissedBy != NoPlayer &&
+                         NeedsCsvQuotes(engine.GetPlayerName(line.dismissedBy));
+            if (quote) {
+                out += '"';
+            }
+            size_t dismissal = out.size();
+            AppendDismissal(out, engine, line);
+            if (quote) {
+                EscapeFrom(out, dismissal, "\"", '"');
+                out += '"';
+            }
+            out += ',';
+            AppendInt(out, line.runs);
+            out += ',';
+            AppendInt(out, line.ballsFaced);
+            out += ',';
+            AppendInt(out, line.fours);
+            out += ',';
+            AppendInt(out, line.sixes);
+            out += ',';
+            AppendFixed(out, line.GetStrikeRate(), 2);
+            out += ",,,,,\n";
+        }
+
+        for (PlayerId id : engine.GetBowlingOrder(1 - side)) {
+            const PlayerMatchStats& line = engine.GetPlayerInningsLine(i, id);
+            if (line.ballsBowled == 0 && line.runsConceded == 0) {
+                continue;
+            }
+            AppendInt(out, i + 1);
+            out += ',';
+            AppendCsvField(out, fielding);
+            out += ",bowling,";
+            AppendCsvField(out, engine.GetPlayerName(id));
+            out += ",,,,,,,";
+            AppendOvers(out, line.ballsBowled);
+            out += ',';
+            AppendInt(out, line.maidens);
+            out += ',';
+            AppendInt(out, line.runsConceded);
+            out += ',';
+            AppendInt(out, line.wickets);
+            out += ',';
+            AppendFixed(out, line.GetEconomy(), 2);
+            out += '\n';
+        }
+    }
+}
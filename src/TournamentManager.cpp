@@ -284,9 +284,8 @@ void TournamentManager::simulateMatch(int matchId) {
         return;
     }
     
-    // Simple simulation without match engine
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Simple simulation without match engine; one stream per fixture
+    RandomStream gen = RandomService::GetStream(RandomDomain::TOURNAMENT, static_cast<uint64_t>(matchId));
     
     // Generate scores based on team strengths
     int team1Strength = match->team1->getTeamStrength();
@@ -1,11 +1,12 @@
 #include "Venue.h"
-#include <random>
+#include <algorithm>
 #include <sstream>
 
 Venue::Venue(const std::string& name, const std::string& location, VenueType type)
     : name(name)
     , location(location)
     , type(type)
+    , weatherRandom(RandomService::GetStream(RandomDomain::WEATHER, RandomService::HashName(name)))
 {
     InitializePitchCharacteristics();
     GenerateWeatherPattern();
@@ -26,15 +27,9 @@ void Venue::SetCurrentWeather(const WeatherPattern& weather) {
 
 void Venue::UpdateWeather() {
     // Simulate weather changes
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> tempChange(-2, 2);
-    std::uniform_int_distribution<> humidityChange(-5, 5);
-    std::uniform_int_distribution<> windChange(-3, 3);
-    
-    currentWeather.temperature += tempChange(gen);
-    currentWeather.humidity += humidityChange(gen);
-    currentWeather.windSpeed += windChange(gen);
+    currentWeather.temperature += weatherRandom.NextInt(-2, 2);
+    currentWeather.humidity += weatherRandom.NextInt(-5, 5);
+    currentWeather.windSpeed += weatherRandom.NextInt(-3, 3);
     
     // Clamp values
     currentWeather.temperature = std::max(-10, std::min(50, currentWeather.temperature));
@@ -62,17 +57,11 @@ void Venue::UpdateWeather() {
 void Venue::GenerateWeatherForecast() {
     weatherForecast.clear();
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> tempVar(-5, 5);
-    std::uniform_int_distribution<> humidityVar(-10, 10);
-    std::uniform_real_distribution<> rainProb(0.0, 1.0);
-    
     for (int i = 0; i < 7; ++i) { // 7-day forecast
         WeatherPattern forecast = currentWeather;
-        forecast.temperature += tempVar(gen);
-        forecast.humidity += humidityVar(gen);
-        forecast.rainProbability = rainProb(gen);
+        forecast.temperature += weatherRandom.NextInt(-5, 5);
+        forecast.humidity += weatherRandom.NextInt(-10, 10);
+        forecast.rainProbability = weatherRandom.NextDouble();
         
         // Clamp values
         forecast.temperature = std::max(-10, std::min(50, forecast.temperature));
@@ -322,21 +311,14 @@ void Venue::InitializePitchCharacteristics() {
 }
 
 void Venue::GenerateWeatherPattern() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> tempDist(15, 35);
-    std::uniform_int_distribution<> humidityDist(40, 80);
-    std::uniform_int_distribution<> windDist(5, 15);
-    std::uniform_real_distribution<> rainProb(0.0, 0.3);
-    
-    currentWeather.temperature = tempDist(gen);
-    currentWeather.humidity = humidityDist(gen);
-    currentWeather.windSpeed = windDist(gen);
+    currentWeather.temperature = weatherRandom.NextInt(15, 35);
+    currentWeather.humidity = weatherRandom.NextInt(40, 80);
+    currentWeather.windSpeed = weatherRandom.NextInt(5, 15);
     currentWeather.windDirection = "North";
     currentWeather.isOvercast = false;
     currentWeather.isRaining = false;
     currentWeather.visibility = 10;
-    currentWeather.rainProbability = rainProb(gen);
+    currentWeather.rainProbability = weatherRandom.NextDouble() * 0.3;
     
     // Set weather type
     if (currentWeather.rainProbability > 0.2) {
@@ -353,24 +335,32 @@ void Venue::GenerateWeatherPattern() {
 
 void Venue::UpdatePitchWear() {
     // Increase wear after each match
-    pitchCharacteristics.wear = std::min(10, pitchCharacteristics.wear + 2);
+    UpdatePitchWear(pitchCharacteristics);
+}
+
+void Venue::UpdatePitchWear(PitchCharacteristics& pitch) const {
+    pitch.wear = std::min(10, pitch.wear + 2);
     
     // Reduce moisture
-    pitchCharacteristics.moisture = std::max(1, pitchCharacteristics.moisture - 1);
+    pitch.moisture = std::max(1, pitch.moisture - 1);
 }
 
 void Venue::CalculatePitchEffects() {
+    CalculatePitchEffects(pitchCharacteristics);
+}
+
+void Venue::CalculatePitchEffects(PitchCharacteristics& pitch) {
     // Recalculate spin and seam effectiveness based on current conditions
-    pitchCharacteristics.isSpinning = (pitchCharacteristics.wear > 6 || 
-                                      pitchCharacteristics.type == PitchType::SPIN_FRIENDLY);
-    pitchCharacteristics.isSeaming = (pitchCharacteristics.moisture > 6 || 
-                                     pitchCharacteristics.grass > 5 ||
-                                     pitchCharacteristics.type == PitchType::SEAM_FRIENDLY);
-    pitchCharacteristics.isBouncy = (pitchCharacteristics.hardness > 7);
+    pitch.isSpinning = (pitch.wear > 6 || 
+                        pitch.type == PitchType::SPIN_FRIENDLY);
+    pitch.isSeaming = (pitch.moisture > 6 || 
+                       pitch.grass > 5 ||
+                       pitch.type == PitchType::SEAM_FRIENDLY);
+    pitch.isBouncy = (pitch.hardness > 7);
     
     // Update effectiveness values
-    pitchCharacteristics.spinEffectiveness = pitchCharacteristics.isSpinning ? 0.8 : 0.5;
-    pitchCharacteristics.seamEffectiveness = pitchCharacteristics.isSeaming ? 0.8 : 0.5;
+    pitch.spinEffectiveness = pitch.isSpinning ? 0.8 : 0.5;
+    pitch.seamEffectiveness = pitch.isSeaming ? 0.8 : 0.5;
 }
 
 std::string Venue::FormatMatchResult(const std::string& team1, const std::string& team2, 
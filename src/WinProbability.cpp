@@ -0,0 +1,151 @@
+#include "WinProbability.h"
+
+WinProbabilityEngine::WinProbabilityEngine(int simulationsPerState)
+    : simulationsPerState(simulationsPerState > 0 ? simulationsPerState : 1)
+    , generation(0)
+    , latestTeam1Probability(-1.0)
+    , stopping(false)
+{
+    worker = std::thread(&WinProbabilityEngine::Run, this);
+}
+
+WinProbabilityEngine::~WinProbabilityEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        pending.clear();
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+uint64_t WinProbabilityEngine::MakeStateKey(int innings, int runs, int wickets, int ballsRemaining, int target) {
+    return static_cast<uint64_t>(innings & 0xF) << 60 |
+           static_cast<uint64_t>(wickets & 0xF) << 56 |
+           static_cast<uint64_t>(ballsRemaining & 0xFFFFFF) << 32 |
+           static_cast<uint64_t>(runs & 0xFFFF) << 16 |
+           static_cast<uint64_t>(target & 0xFFFF);
+}
+
+bool WinProbabilityEngine::Lookup(uint64_t key, double& probability) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        return false;
+    }
+    probability = it->second;
+    return true;
+}
+
+double WinProbabilityEngine::GetLatestTeam1Probability() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return latestTeam1Probability;
+}
+
+void WinProbabilityEngine::Submit(uint64_t key, const MatchEngine::ScoreState& state, TeamId battingTeam, bool lookahead) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.clear();
+        pending.push_back(Request{key, state, battingTeam, lookahead});
+    }
+    wake.notify_one();
+}
+
+void WinProbabilityEngine::Clear(std::unique_ptr<MatchEngine> configuration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.clear();
+    pending.clear();
+    nextConfiguration = std::move(configuration);
+    generation++;
+    latestTeam1Probability = -1.0;
+}
+
+void WinProbabilityEngine::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (stopping) {
+            return;
+        }
+
+        Request request = std::move(pending.front());
+        pending.pop_front();
+        if (nextConfiguration) {
+            engine = std::move(nextConfiguration);
+        }
+        if (!engine) {
+            continue;
+        }
+
+        uint64_t startedGeneration = generation;
+        lock.unlock();
+        std::vector<Request> states = ExpandRequest(std::move(request));
+        lock.lock();
+
+        // The requested state first, then its likely successors; a newer
+        // request or a Clear abandons whatever is left
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (stopping || generation != startedGeneration || !pending.empty()) {
+                break;
+            }
+            auto cached = cache.find(states[i].key);
+            if (cached == cache.end()) {
+                lock.unlock();
+                double probability = Estimate(states[i]);
+                lock.lock();
+                if (generation != startedGeneration) {
+                    break;
+                }
+                cached = cache.emplace(states[i].key, probability).first;
+            }
+            if (i == 0) {
+                latestTeam1Probability = states[i].battingTeam == 0 ? cached->second : 1.0 - cached->second;
+            }
+        }
+    }
+}
+
+std::vector<WinProbabilityEngine::Request> WinProbabilityEngine::ExpandRequest(Request request) {
+    static const BallResult likelyOutcomes[] = {
+        BallResult::DOT_BALL, BallResult::SINGLE, BallResult::DOUBLE, BallResult::FOUR,
+        BallResult::SIX, BallResult::WICKET, BallResult::WIDE
+    };
+
+    std::vector<Request> states;
+    bool lookahead = request.lookahead;
+    states.push_back(std::move(request));
+    if (!lookahead) {
+        return states;
+    }
+    for (BallResult outcome : likelyOutcomes) {
+        engine->RestoreScoreState(states.front().state);
+        engine->ApplyBallOutcome(outcome);
+        if (engine->IsMatchComplete()) {
+            continue;
+        }
+        states.push_back(Request{engine->GetWinStateKey(), engine->TakeScoreState(),
+                                 engine->GetMatchState().battingTeam, false});
+    }
+    return states;
+}
+
+double WinProbabilityEngine::Estimate(const Request& request) {
+    // Replay the state with a different stream per run
+    engine->SetSimulationFidelity(SimulationFidelity::SCORE_ONLY);
+    uint64_t baseSeed = RandomService::Mix(request.state.randomSeed ^ request.key);
+
+    double wins = 0.0;
+    for (int i = 0; i < simulationsPerState; ++i) {
+        engine->RestoreScoreState(request.state);
+        engine->SetRandomSeed(RandomService::Mix(baseSeed + i));
+        engine->SimulateMatch();
+
+        const MatchState& state = engine->GetMatchState();
+        if (state.isTie) {
+            wins += 0.5;
+        } else if (state.winner == request.battingTeam) {
+            wins += 1.0;
+        }
+    }
+    return wins / simulationsPerState;
+}
@@ -15,66 +15,234 @@
 #include <nlohmann/json.hpp>
 #include <limits>
 #include <regex>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include "MatchEngine.h"
+#include "RandomStream.h"
 
 using json = nlohmann::json;
 
 // Forward declarations for IPL Cricket Manager components
+enum class Nationality : uint8_t { INDIAN, OVERSEAS };
+
+// Ratings are whole numbers out of 100, so a byte each is enough
+struct PlayerRatings {
+    uint8_t batting = 0;
+    uint8_t bowling = 0;
+    uint8_t fielding = 0;
+    
+    float Average() const { return (batting + bowling + fielding) / 3.0f; }
+};
+
 class IPLPlayer {
 public:
+    // What the match and auction loops read sits together at the front;
+    // labels are only made when something is displayed
+    PlayerRatings ratings;
+    PlayerRole role;
+    Nationality nationality;
+    BattingApproach battingApproach;
+    uint8_t age;
+    float price;
     std::string name;
     std::string team;
-    std::string role; // Batsman, Bowler, All-rounder, Wicket-keeper
-    std::string nationality; // Indian, Overseas
-    std::string battingApproach; // Aggressive, Defensive, Balanced, Attacking
-    float battingRating;
-    float bowlingRating;
-    float fieldingRating;
-    float price;
-    int age;
-    std::string speciality; // Power hitter, Death bowler, etc.
     
-    IPLPlayer() : battingRating(0), bowlingRating(0), fieldingRating(0), price(0), age(0) {}
+    IPLPlayer() : role(PlayerRole::BATSMAN), nationality(Nationality::INDIAN), battingApproach(BattingApproach::BALANCED), age(0), price(0) {}
 };
 
+static const char* roleLabel(PlayerRole role) {
+    switch (role) {
+        case PlayerRole::BOWLER: return "Bowler";
+        case PlayerRole::ALL_ROUNDER: return "All-rounder";
+        case PlayerRole::WICKET_KEEPER: return "Wicket-keeper";
+        case PlayerRole::CAPTAIN: return "Captain";
+        default: return "Batsman";
+    }
+}
+
+static const char* nationalityLabel(Nationality nationality) {
+    return nationality == Nationality::OVERSEAS ? "Overseas" : "Indian";
+}
+
+static const char* approachLabel(BattingApproach approach) {
+    switch (approach) {
+        case BattingApproach::AGGRESSIVE: return "Aggressive";
+        case BattingApproach::DEFENSIVE: return "Defensive";
+        case BattingApproach::ATTACKING: return "Attacking";
+        default: return "Balanced";
+    }
+}
+
+// Dense index into IPLManager's team registry. Fixtures, results and the
+// manager's club refer to teams by this; names are looked up for display.
+using FranchiseId = uint8_t;
+constexpr FranchiseId NoFranchise = 0xFF; // unset, or nobody (a tied match)
+
 class IPLTeam {
 public:
     std::string name;
     std::string city;
     std::string homeGround;
     std::string captain;
-    std::vector<IPLPlayer> players;
-    float budget;
     int points;
     float netRunRate;
     int wins;
     int losses;
     int ties;
     
-    IPLTeam() : budget(120.0f), points(0), netRunRate(0.0f), wins(0), losses(0), ties(0) {}
+    IPLTeam() : points(0), netRunRate(0.0f), wins(0), losses(0), ties(0) {}
 };
 
 // Add AI strategy enum and AI team struct
 enum class AIStrategy { AGGRESSIVE, BALANCED, CONSERVATIVE, WILDCARD };
 
+// Squad make-up, counted as players join so auction checks never rescan
+struct SquadStats {
+    int totalPlayers = 0;
+    int wicketKeepers = 0;
+    int allRounders = 0;
+    int bowlers = 0;
+    int batsmen = 0;
+    int indians = 0;
+    int overseas = 0;
+    
+    void Add(const IPLPlayer& player) {
+        totalPlayers++;
+        switch (player.role) {
+            case PlayerRole::WICKET_KEEPER: wicketKeepers++; break;
+            case PlayerRole::ALL_ROUNDER: allRounders++; break;
+            case PlayerRole::BOWLER: bowlers++; break;
+            case PlayerRole::BATSMAN: batsmen++; break;
+            default: break;
+        }
+        if (player.nationality == Nationality::INDIAN) indians++;
+        else overseas++;
+    }
+    
+    // Short of the role's minimum, or of the 18-man minimum squad
+    bool Needs(PlayerRole role) const {
+        if (role == PlayerRole::WICKET_KEEPER && wicketKeepers < 1) return true;
+        if (role == PlayerRole::ALL_ROUNDER && allRounders < 3) return true;
+        if (role == PlayerRole::BOWLER && bowlers < 5) return true;
+        if (role == PlayerRole::BATSMAN && batsmen < 5) return true;
+        return totalPlayers < 18;
+    }
+};
+
+// Auction and squad state for the registry entry with the same id
 struct AITeam {
-    IPLTeam team;
+    FranchiseId id;
     float budget;
-    int overseasCount;
     AIStrategy strategy;
     std::vector<IPLPlayer> squad;
+    SquadStats stats; // always in step with squad; add players through AddPlayer
+    
+    void AddPlayer(const IPLPlayer& player) {
+        squad.push_back(player);
+        stats.Add(player);
+    }
+};
+
+// Compact record of a delivery worth reporting. The draw picks the
+// commentary lines, so nothing is formatted until the note is printed.
+struct BallNote {
+    int over;
+    int ball;
+    int runs;
+    bool wicket;
+    const IPLPlayer* batter;
+    uint32_t draw;
+};
+
+static const char* const wicketLines[] = {
+    " is clean bowled!", " edges it to the keeper!", " caught at mid-wicket!", " LBW! That's plumb!",
+    " stumped! Brilliant work by the keeper!", " run out! What a mix-up!", " caught at deep mid-wicket!",
+    " bowled around the legs!"
+};
+static const char* const fourLines[] = {
+    " drives it beautifully through the covers!", " cuts it past point for a boundary!",
+    " pulls it to the mid-wicket boundary!", " flicks it fine for four!", " square drives it to the boundary!",
+    " plays a lovely shot through extra cover!", " hits it over the bowler's head!", " guides it past third man!"
+};
+static const char* const sixLines[] = {
+    " launches it over long-on for a maximum!", " smashes it over mid-wicket!", " hits it over the covers for six!",
+    " pulls it over square leg!", " drives it straight down the ground!", " scoops it over fine leg!",
+    " reverse sweeps it over point!", " hits it over long-off!"
+};
+static const char* const singleLines[] = {
+    " takes a quick single.", " works it to mid-wicket for one.", " pushes it to cover for a single.",
+    " taps it to point for one run."
+};
+static const char* const twoLines[] = {
+    " runs hard for two.", " places it in the gap for a couple.", " works it to deep square leg for two."
+};
+static const char* const threeLines[] = {
+    " runs three! Good running between the wickets.", " places it perfectly for three runs."
 };
+static const char* const dotLines[] = {
+    " defends it solidly.", " leaves it alone.", " blocks it back to the bowler.", " plays it to mid-off.",
+    " lets it go through to the keeper."
+};
+
+// Percentage of 0-3 run balls that get a line, indexed by runs
+static const int quietBallChance[] = {20, 30, 40, 50};
+
+template <size_t N>
+static const char* pickLine(const char* const (&lines)[N], uint32_t draw) {
+    return lines[draw % N];
+}
+
+static bool hasQuietLine(const BallNote& note) {
+    if (!note.batter || note.runs < 0 || note.runs > 3) return false;
+    return static_cast<int>((note.draw >> 16) % 10) * 10 < quietBallChance[note.runs];
+}
+
+static bool isKeyMoment(const BallNote& note) {
+    return note.wicket || note.runs == 4 || note.runs == 6 || hasQuietLine(note);
+}
+
+static std::string describeKeyMoment(const BallNote& note) {
+    std::string event;
+    const std::string name = note.batter ? note.batter->name : "";
+    if (note.wicket) {
+        event = note.batter ? "WICKET! " + name + pickLine(wicketLines, note.draw) + " " : "WICKET! ";
+    }
+    uint32_t draw = note.draw >> 8;
+    switch (note.runs) {
+        case 4: event += note.batter ? "FOUR! " + name + pickLine(fourLines, draw) + " " : "FOUR! "; break;
+        case 6: event += note.batter ? "SIX! " + name + pickLine(sixLines, draw) + " " : "SIX! "; break;
+        case 0: if (hasQuietLine(note)) event += name + pickLine(dotLines, draw) + " "; break;
+        case 1: if (hasQuietLine(note)) event += name + pickLine(singleLines, draw) + " "; break;
+        case 2: if (hasQuietLine(note)) event += name + pickLine(twoLines, draw) + " "; break;
+        case 3: if (hasQuietLine(note)) event += name + pickLine(threeLines, draw) + " "; break;
+        default: break;
+    }
+    return event;
+}
 
 class IPLManager {
 public:
     IPLManager();
+    explicit IPLManager(std::ostream& output);
     ~IPLManager();
     
     bool initialize();
     void run();
     void cleanup();
     
+    // Non-interactive seasons for balance studies: auction, league and
+    // playoffs end to end with no terminal I/O, one JSON line per season
+    struct HeadlessOptions {
+        int seasons = 1;
+        unsigned int threads = 0; // 0 = hardware concurrency
+        std::string outPath;      // empty = standard output
+    };
+    static int runHeadless(const HeadlessOptions& options);
+    
 private:
     bool isRunning;
+    bool curlInitialized;
     void handleInput();
     void update();
     void render();
@@ -100,7 +268,7 @@ private:
     struct ManagerProfile {
         std::string name;
         std::string avatar;
-        std::string selectedTeam;
+        FranchiseId selectedTeam;
         int careerYear;
         int totalMatches;
         int totalWins;
@@ -111,26 +279,30 @@ private:
     
     ManagerProfile managerProfile;
     
-    // IPL Data
+    // IPL Data. iplTeams is the team registry, indexed by FranchiseId;
+    // aiTeams holds each team's squad at the same index.
     std::vector<IPLTeam> iplTeams;
     std::vector<IPLPlayer> availablePlayers;
     std::vector<IPLPlayer> auctionPlayers;
     
     // Season Data
     struct Match {
-        std::string team1;
-        std::string team2;
+        FranchiseId team1;
+        FranchiseId team2;
         std::string venue;
         std::string date;
         bool isPlayed;
-        std::string winner;
+        FranchiseId winner = NoFranchise;
         int team1Score;
         int team2Score;
     };
     
     std::vector<Match> seasonFixtures;
+    std::vector<Match> playoffFixtures;
+    std::vector<FranchiseId> standings; // league order, set by calculatePlayoffs
     int currentMatchIndex;
     bool seasonInProgress;
+    uint32_t seasonIndex; // keys the player pool and match streams apart between seasons
     
     // AI Data
     std::vector<AITeam> aiTeams;
@@ -138,6 +310,12 @@ private:
     // Auction state
     bool auctionComplete = false;
     
+    // Shared stream for auction, squad and super over draws
+    RandomStream rng;
+    
+    // Everything the game prints; headless seasons discard it
+    std::ostream& output;
+    
     // UI Methods
     void showMainMenu();
     void showAvatarCustomization();
@@ -155,8 +333,12 @@ private:
     void loadPlayersFromAPI();
     void generateSeasonFixtures();
     void simulateMatch(Match& match);
+    void playMatch(Match& match, std::ostream& out);
+    void recordResult(const Match& match);
     void updateLeagueTable();
     void calculatePlayoffs();
+    void simulatePlayoffs();
+    json simulateHeadlessSeason(uint32_t season);
     
     // Utility Methods
     void clearScreen();
@@ -167,6 +349,10 @@ private:
     void waitForInput();
     std::string getInput();
     
+    // Team registry lookups
+    const std::string& teamName(FranchiseId id) const;
+    AITeam* managerTeam();
+    
     // API Integration
     static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
     std::string fetchFromAPI(const std::string& url);
@@ -185,9 +371,10 @@ private:
     
     // New method for simulating entire season
     void simulateEntireSeason();
+    void simulateRound(const std::vector<Match*>& round);
     
     // Simulate a Super Over between two teams
-    std::string simulateSuperOver(const std::string& team1, const std::string& team2);
+    FranchiseId simulateSuperOver(FranchiseId team1, FranchiseId team2, RandomStream& gen, std::ostream& out);
     
     // Helper: Get available bowlers for a team (max 4 overs per bowler)
     std::vector<IPLPlayer*> getAvailableBowlers(AITeam& team, std::map<std::string, int>& bowlerOvers);
@@ -198,6 +385,12 @@ private:
     // Helper: Auto-simulate matches not involving manager's team
     void autoSimulateOtherMatches();
     
+    // Helper: Play a fixture on the engine's score-only path
+    std::string simulateEngineMatch(Match& match, uint32_t matchIndex, bool superOver);
+    
+    // Helper: Build an engine Team (playing XI in batting order) from an AI squad
+    std::unique_ptr<Team> buildEngineTeam(const AITeam& team);
+    
     // Helper: Show squad with detailed information
     void showDetailedSquad();
     
@@ -209,31 +402,27 @@ private:
     
     // Helper: Validate team squad requirements
     bool validateSquadRequirements(const AITeam& team);
-    
-    // Helper: Get team squad statistics
-    struct SquadStats {
-        int totalPlayers;
-        int wicketKeepers;
-        int allRounders;
-        int bowlers;
-        int batsmen;
-        int indians;
-        int overseas;
-    };
-    SquadStats getSquadStats(const AITeam& team);
 };
 
 // Constructor
-IPLManager::IPLManager() 
+IPLManager::IPLManager()
+    : IPLManager(std::cout) {
+}
+
+IPLManager::IPLManager(std::ostream& output) 
     : isRunning(false)
+    , curlInitialized(false)
     , currentState(GameState::MAIN_MENU)
     , currentMatchIndex(0)
-    , seasonInProgress(false) {
+    , seasonInProgress(false)
+    , seasonIndex(0)
+    , rng(RandomService::GetStream(RandomDomain::SEASON))
+    , output(output) {
     
     // Initialize manager profile
     managerProfile.name = "";
     managerProfile.avatar = "Default";
-    managerProfile.selectedTeam = "";
+    managerProfile.selectedTeam = NoFranchise;
     managerProfile.careerYear = 1;
     managerProfile.totalMatches = 0;
     managerProfile.totalWins = 0;
@@ -249,15 +438,16 @@ IPLManager::~IPLManager() {
 bool IPLManager::initialize() {
     clearScreen();
     printBanner("🏏 IPL CRICKET MANAGER 2025 🏏");
-    std::cout << "\n";
+    output << "\n";
     printCentered("Version: 1.0.0 - Professional Edition");
     printCentered("Platform: Console Mode");
     printCentered("Graphics: Professional ASCII UI");
-    std::cout << "\n";
+    output << "\n";
     printCentered("Loading IPL data and initializing game...");
     
     // Initialize CURL
     curl_global_init(CURL_GLOBAL_DEFAULT);
+    curlInitialized = true;
     
     // Initialize IPL teams
     initializeIPLTeams();
@@ -266,9 +456,9 @@ bool IPLManager::initialize() {
     loadPlayersFromAPI();
     
     isRunning = true;
-    std::cout << "\n";
+    output << "\n";
     printCentered("✅ Game initialized successfully!");
-    std::cout << "\n";
+    output << "\n";
     waitForInput();
     
     return true;
@@ -286,11 +476,126 @@ void IPLManager::run() {
 }
 
 void IPLManager::cleanup() {
-    std::cout << "Cleaning up IPL Manager..." << std::endl;
-    curl_global_cleanup();
+    // Headless managers never initialized anything global
+    if (curlInitialized) {
+        output << "Cleaning up IPL Manager..." << std::endl;
+        curl_global_cleanup();
+        curlInitialized = false;
+    }
     isRunning = false;
 }
 
+int IPLManager::runHeadless(const HeadlessOptions& options) {
+    std::ofstream file;
+    if (!options.outPath.empty()) {
+        file.open(options.outPath);
+        if (!file) {
+            std::cerr << "Cannot open " << options.outPath << " for writing" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Results get a stream of their own; each season's manager prints to a
+    // stream with no buffer, which discards everything
+    std::ostream results(options.outPath.empty() ? std::cout.rdbuf() : file.rdbuf());
+    
+    unsigned int threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned int>(threads, options.seasons);
+    
+    // Seasons finish out of order across threads but are written in order,
+    // so the file depends only on the seed
+    std::atomic<int> nextSeason{0};
+    std::mutex outputMutex;
+    std::vector<std::string> lines(options.seasons);
+    std::vector<bool> finished(options.seasons, false);
+    int nextToWrite = 0;
+    auto worker = [&]() {
+        for (int season = nextSeason++; season < options.seasons; season = nextSeason++) {
+            std::ostream silent(nullptr);
+            IPLManager manager(silent);
+            std::string line = manager.simulateHeadlessSeason(static_cast<uint32_t>(season)).dump();
+            
+            std::lock_guard<std::mutex> lock(outputMutex);
+            lines[season] = std::move(line);
+            finished[season] = true;
+            while (nextToWrite < options.seasons && finished[nextToWrite]) {
+                results << lines[nextToWrite] << '\n';
+                std::string().swap(lines[nextToWrite]);
+                nextToWrite++;
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    results.flush();
+    if (!results) {
+        std::cerr << "Failed writing results" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+json IPLManager::simulateHeadlessSeason(uint32_t season) {
+    // Season 0 draws what an interactive career's first season would
+    seasonIndex = season;
+    rng = RandomService::GetStream(RandomDomain::SEASON, season);
+    
+    initializeIPLTeams();
+    loadPlayersFromAPI();
+    simulateAuction();
+    generateSeasonFixtures();
+    autoSimulateOtherMatches();
+    updateLeagueTable();
+    simulatePlayoffs();
+    
+    auto fixtureJson = [this](const Match& match) {
+        return json{
+            {"match", match.date},
+            {"team1", teamName(match.team1)},
+            {"team2", teamName(match.team2)},
+            {"venue", match.venue},
+            {"team1Score", match.team1Score},
+            {"team2Score", match.team2Score},
+            {"winner", match.winner == NoFranchise ? "Tie" : teamName(match.winner)}
+        };
+    };
+    
+    json result;
+    result["season"] = season;
+    result["seed"] = RandomService::GetSeed();
+    result["champion"] = playoffFixtures.empty() ? "" : teamName(playoffFixtures.back().winner);
+    result["table"] = json::array();
+    for (FranchiseId id : standings) {
+        const IPLTeam& team = iplTeams[id];
+        result["table"].push_back({
+            {"team", team.name},
+            {"played", team.wins + team.losses + team.ties},
+            {"won", team.wins},
+            {"lost", team.losses},
+            {"tied", team.ties},
+            {"points", team.points},
+            {"netRunRate", team.netRunRate}
+        });
+    }
+    result["playoffs"] = json::array();
+    for (const auto& match : playoffFixtures) {
+        result["playoffs"].push_back(fixtureJson(match));
+    }
+    result["matches"] = json::array();
+    for (const auto& match : seasonFixtures) {
+        result["matches"].push_back(fixtureJson(match));
+    }
+    return result;
+}
+
 void IPLManager::handleInput() {
     std::string input = getInput();
     
@@ -308,14 +613,14 @@ void IPLManager::handleInput() {
             
         case GameState::AVATAR_CUSTOMIZATION:
             if (input == "1") {
-                std::cout << "Enter your manager name: ";
+                output << "Enter your manager name: ";
                 std::getline(std::cin, managerProfile.name);
             } else if (input == "2") {
-                std::cout << "Select avatar:\n";
+                output << "Select avatar:\n";
                 for (int i = 1; i <= 5; ++i) {
-                    std::cout << "  " << i << ". Avatar_" << i << "\n";
+                    output << "  " << i << ". Avatar_" << i << "\n";
                 }
-                std::cout << "Enter avatar number (1-5): ";
+                output << "Enter avatar number (1-5): ";
                 std::string avatarChoice = getInput();
                 int choice = std::stoi(avatarChoice);
                 if (choice >= 1 && choice <= 5) {
@@ -325,7 +630,7 @@ void IPLManager::handleInput() {
                 if (!managerProfile.name.empty()) {
                     currentState = GameState::TEAM_SELECTION;
                 } else {
-                    std::cout << "Please enter your name first!" << std::endl;
+                    output << "Please enter your name first!" << std::endl;
                     waitForInput();
                 }
             } else if (input == "0") {
@@ -339,7 +644,7 @@ void IPLManager::handleInput() {
             } else {
                 int teamChoice = std::stoi(input);
                 if (teamChoice >= 1 && teamChoice <= iplTeams.size()) {
-                    managerProfile.selectedTeam = iplTeams[teamChoice - 1].name;
+                    managerProfile.selectedTeam = static_cast<FranchiseId>(teamChoice - 1);
                     currentState = GameState::AUCTION;
                 }
             }
@@ -354,7 +659,7 @@ void IPLManager::handleInput() {
                     generateSeasonFixtures();
                     seasonInProgress = true;
                 } else {
-                    std::cout << "Please complete the auction first!" << std::endl;
+                    output << "Please complete the auction first!" << std::endl;
                     waitForInput();
                 }
             } else if (input == "1") {
@@ -417,6 +722,12 @@ void IPLManager::handleInput() {
             if (input == "0") {
                 currentState = GameState::SEASON_CALENDAR;
             } else if (input == "1") {
+                updateLeagueTable();
+                simulatePlayoffs();
+                if (!playoffFixtures.empty() && playoffFixtures.back().winner == managerProfile.selectedTeam) {
+                    managerProfile.championships++;
+                }
+                waitForInput();
                 currentState = GameState::CAREER_SUMMARY;
             }
             break;
@@ -427,6 +738,7 @@ void IPLManager::handleInput() {
             } else if (input == "1") {
                 // Start new season
                 managerProfile.careerYear++;
+                seasonIndex++;
                 currentMatchIndex = 0;
                 seasonInProgress = false;
                 currentState = GameState::SEASON_CALENDAR;
@@ -520,7 +832,7 @@ void IPLManager::render() {
             showSettings();
             break;
         case GameState::EXIT:
-            std::cout << "Exiting IPL Cricket Manager..." << std::endl;
+            output << "Exiting IPL Cricket Manager..." << std::endl;
             break;
     }
     
@@ -530,207 +842,196 @@ void IPLManager::render() {
 // UI Methods
 void IPLManager::showMainMenu() {
     printBanner("🏠 MAIN MENU");
-    std::cout << "\n";
+    output << "\n";
     printCentered("Welcome to IPL Cricket Manager 2025!");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. Start Career                                             ║\n";
-    std::cout << "║  2. Settings                                                 ║\n";
-    std::cout << "║  3. Quit Game                                                ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (1-3): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  1. Start Career                                             ║\n";
+    output << "║  2. Settings                                                 ║\n";
+    output << "║  3. Quit Game                                                ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (1-3): ";
 }
 
 void IPLManager::showAvatarCustomization() {
     printBanner("👤 AVATAR CUSTOMIZATION");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Current Profile:                                           ║\n";
-    std::cout << "║  Name: " << std::left << std::setw(50) << managerProfile.name << "║\n";
-    std::cout << "║  Avatar: " << std::left << std::setw(47) << managerProfile.avatar << "║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. Set Name                                                ║\n";
-    std::cout << "║  2. Select Avatar                                           ║\n";
-    std::cout << "║  3. Continue to Team Selection                              ║\n";
-    std::cout << "║  0. Go Back                                                 ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-3): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  Current Profile:                                           ║\n";
+    output << "║  Name: " << std::left << std::setw(50) << managerProfile.name << "║\n";
+    output << "║  Avatar: " << std::left << std::setw(47) << managerProfile.avatar << "║\n";
+    output << "║                                                              ║\n";
+    output << "║  1. Set Name                                                ║\n";
+    output << "║  2. Select Avatar                                           ║\n";
+    output << "║  3. Continue to Team Selection                              ║\n";
+    output << "║  0. Go Back                                                 ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0-3): ";
 }
 
 void IPLManager::showTeamSelection() {
     printBanner("🏏 TEAM SELECTION");
-    std::cout << "\n";
+    output << "\n";
     printCentered("Choose your IPL team for the 2025 season!\n");
     
     // Display team logos and information
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Available Teams:                                            ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════╣\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║  Available Teams:                                            ║\n";
+    output << "╠══════════════════════════════════════════════════════════════╣\n";
     
     for (size_t i = 0; i < iplTeams.size(); i++) {
         std::string logo = getTeamLogo(iplTeams[i].name);
-        std::string marker = (managerProfile.selectedTeam == iplTeams[i].name) ? "▶ " : "  ";
+        std::string marker = (managerProfile.selectedTeam == i) ? "▶ " : "  ";
         
-        std::cout << "║  " << marker << std::left << std::setw(2) << (i + 1) << ". " << std::setw(25) << iplTeams[i].name;
-        std::cout << " | " << std::setw(15) << iplTeams[i].city;
-        std::cout << " | " << std::setw(8) << std::fixed << std::setprecision(1) << iplTeams[i].budget << "Cr ║\n";
+        output << "║  " << marker << std::left << std::setw(2) << (i + 1) << ". " << std::setw(25) << iplTeams[i].name;
+        output << " | " << std::setw(15) << iplTeams[i].city;
+        output << " | " << std::setw(8) << std::fixed << std::setprecision(1) << aiTeams[i].budget << "Cr ║\n";
         
         // Display team logo
         if (!logo.empty()) {
-            std::cout << "║     " << logo << std::setw(45 - logo.length()) << " ║\n";
+            output << "║     " << logo << std::setw(45 - logo.length()) << " ║\n";
         }
         
         if (i < iplTeams.size() - 1) {
-            std::cout << "║                                                                  ║\n";
+            output << "║                                                                  ║\n";
         }
     }
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
     
-    std::cout << "\n";
-    std::cout << "Enter team number (1-" << iplTeams.size() << ") or 0 to return: ";
+    output << "\n";
+    output << "Enter team number (1-" << iplTeams.size() << ") or 0 to return: ";
 }
 
 void IPLManager::showAuction() {
     printBanner("💰 PLAYER AUCTION");
-    std::cout << "\n";
+    output << "\n";
     printCentered("Build your squad for the 2025 IPL season!\n");
     
     // Only run auction if user squad < 18
     if (auctionComplete) {
-        std::cout << "Auction complete!\n";
-        std::cout << "Type 5 to proceed to the season." << std::endl;
-        std::cout << "Enter your choice: ";
+        output << "Auction complete!\n";
+        output << "Type 5 to proceed to the season." << std::endl;
+        output << "Enter your choice: ";
         return;
     }
     
     // User's team
-    AITeam* userTeam = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == managerProfile.selectedTeam) {
-            userTeam = &ai;
-            break;
-        }
-    }
+    AITeam* userTeam = managerTeam();
     if (!userTeam) return;
     
     // Show auction options
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Selected Team: " << std::left << std::setw(40) << managerProfile.selectedTeam << "║\n";
-    std::cout << "║  Budget: ₹120 Crore                                         ║\n";
-    std::cout << "║  Squad Size: 18-25 players                                  ║\n";
-    std::cout << "║  Overseas Players: Max 8 in squad, Max 4 in XI              ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. Manual Auction (Bid for each player)                     ║\n";
-    std::cout << "║  2. Simulate Auction (Auto-build all teams)                  ║\n";
-    std::cout << "║  3. View Available Players                                   ║\n";
-    std::cout << "║  4. View Current Squad                                       ║\n";
-    std::cout << "║  5. Continue to Season                                       ║\n";
-    std::cout << "║  0. Go Back                                                  ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  6. Simulate Entire Season (Show only final scores)          ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-6): ";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  Selected Team: " << std::left << std::setw(40) << teamName(managerProfile.selectedTeam) << "║\n";
+    output << "║  Budget: ₹120 Crore                                         ║\n";
+    output << "║  Squad Size: 18-25 players                                  ║\n";
+    output << "║  Overseas Players: Max 8 in squad, Max 4 in XI              ║\n";
+    output << "║                                                              ║\n";
+    output << "║  1. Manual Auction (Bid for each player)                     ║\n";
+    output << "║  2. Simulate Auction (Auto-build all teams)                  ║\n";
+    output << "║  3. View Available Players                                   ║\n";
+    output << "║  4. View Current Squad                                       ║\n";
+    output << "║  5. Continue to Season                                       ║\n";
+    output << "║  0. Go Back                                                  ║\n";
+    output << "║                                                              ║\n";
+    output << "║  6. Simulate Entire Season (Show only final scores)          ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0-6): ";
 }
 
 void IPLManager::showSeasonCalendar() {
     printBanner("📅 SEASON CALENDAR");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Season: " << std::left << std::setw(47) << managerProfile.careerYear << "║\n";
-    std::cout << "║  Team: " << std::left << std::setw(50) << managerProfile.selectedTeam << "║\n";
-    std::cout << "║  Matches Played: " << std::left << std::setw(41) << currentMatchIndex << "║\n";
-    std::cout << "║  Total Matches: " << std::left << std::setw(41) << seasonFixtures.size() << "║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. View League Table                                        ║\n";
-    std::cout << "║  2. Simulate Next Match                                      ║\n";
-    std::cout << "║  3. View Detailed Squad                                      ║\n";
-    std::cout << "║  4. Continue Season                                          ║\n";
-    std::cout << "║  0. Go Back                                                  ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-4): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  Season: " << std::left << std::setw(47) << managerProfile.careerYear << "║\n";
+    output << "║  Team: " << std::left << std::setw(50) << teamName(managerProfile.selectedTeam) << "║\n";
+    output << "║  Matches Played: " << std::left << std::setw(41) << currentMatchIndex << "║\n";
+    output << "║  Total Matches: " << std::left << std::setw(41) << seasonFixtures.size() << "║\n";
+    output << "║                                                              ║\n";
+    output << "║  1. View League Table                                        ║\n";
+    output << "║  2. Simulate Next Match                                      ║\n";
+    output << "║  3. View Detailed Squad                                      ║\n";
+    output << "║  4. Continue Season                                          ║\n";
+    output << "║  0. Go Back                                                  ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0-4): ";
 }
 
 void IPLManager::showMatchSimulation() {
     printBanner("🏏 MATCH SIMULATION");
-    std::cout << "\n";
+    output << "\n";
     
     if (currentMatchIndex < seasonFixtures.size()) {
         Match& currentMatch = seasonFixtures[currentMatchIndex];
         
-        std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "║  Match " << (currentMatchIndex + 1) << " of " << seasonFixtures.size() << "                          ║\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "║  " << std::left << std::setw(25) << currentMatch.team1 << " vs " 
-                  << std::setw(25) << currentMatch.team2 << " ║\n";
-        std::cout << "║  Venue: " << std::left << std::setw(47) << currentMatch.venue << "║\n";
-        std::cout << "║  Date: " << std::left << std::setw(49) << currentMatch.date << "║\n";
-        std::cout << "║                                                              ║\n";
+        output << "╔══════════════════════════════════════════════════════════════╗\n";
+        output << "║                                                              ║\n";
+        output << "║  Match " << (currentMatchIndex + 1) << " of " << seasonFixtures.size() << "                          ║\n";
+        output << "║                                                              ║\n";
+        output << "║  " << std::left << std::setw(25) << teamName(currentMatch.team1) << " vs " 
+                  << std::setw(25) << teamName(currentMatch.team2) << " ║\n";
+        output << "║  Venue: " << std::left << std::setw(47) << currentMatch.venue << "║\n";
+        output << "║  Date: " << std::left << std::setw(49) << currentMatch.date << "║\n";
+        output << "║                                                              ║\n";
         
         if (currentMatch.isPlayed) {
-            std::cout << "║  Result: " << std::left << std::setw(46) << currentMatch.winner << "║\n";
-            std::cout << "║  Score: " << currentMatch.team1Score << " - " << currentMatch.team2Score << "                                    ║\n";
+            output << "║  Result: " << std::left << std::setw(46) << (currentMatch.winner == NoFranchise ? "Tie" : teamName(currentMatch.winner)) << "║\n";
+            output << "║  Score: " << currentMatch.team1Score << " - " << currentMatch.team2Score << "                                    ║\n";
         } else {
-            std::cout << "║  Status: Not Played                                        ║\n";
+            output << "║  Status: Not Played                                        ║\n";
         }
         
-        std::cout << "║                                                              ║\n";
-        std::cout << "║  🏏 simulate. Simulate Match                                ║\n";
-        std::cout << "║  ⬅️  back. Go Back                                          ║\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+        output << "║                                                              ║\n";
+        output << "║  🏏 simulate. Simulate Match                                ║\n";
+        output << "║  ⬅️  back. Go Back                                          ║\n";
+        output << "║                                                              ║\n";
+        output << "╚══════════════════════════════════════════════════════════════╝\n";
     } else {
-        std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "║  All matches completed!                                     ║\n";
-        std::cout << "║  Proceeding to playoffs...                                  ║\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "║  1. Continue to Playoffs                                    ║\n";
-        std::cout << "║  0. Go Back                                                 ║\n";
-        std::cout << "║                                                              ║\n";
-        std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    }
-    
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-1): ";
+        output << "╔══════════════════════════════════════════════════════════════╗\n";
+        output << "║                                                              ║\n";
+        output << "║  All matches completed!                                     ║\n";
+        output << "║  Proceeding to playoffs...                                  ║\n";
+        output << "║                                                              ║\n";
+        output << "║  1. Continue to Playoffs                                    ║\n";
+        output << "║  0. Go Back                                                 ║\n";
+        output << "║                                                              ║\n";
+        output << "╚══════════════════════════════════════════════════════════════╝\n";
+    }
+    
+    output << "\n";
+    output << "Enter your choice (0-1): ";
 }
 
 void IPLManager::showLeagueTable() {
     printBanner("📊 LEAGUE TABLE");
-    std::cout << "\n";
+    output << "\n";
     
     // Sort teams by points, then by NRR
-    std::vector<IPLTeam> sortedTeams = iplTeams;
-    std::sort(sortedTeams.begin(), sortedTeams.end(), 
-              [](const IPLTeam& a, const IPLTeam& b) {
-                  if (a.points != b.points) return a.points > b.points;
-                  return a.netRunRate > b.netRunRate;
-              });
+    calculatePlayoffs();
     
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Pos  Team                P   W   L   T   NRR    Points     ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════╣\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║  Pos  Team                P   W   L   T   NRR    Points     ║\n";
+    output << "╠══════════════════════════════════════════════════════════════╣\n";
     
-    for (size_t i = 0; i < sortedTeams.size(); i++) {
-        const IPLTeam& team = sortedTeams[i];
-        std::string marker = (team.name == managerProfile.selectedTeam) ? "▶ " : "  ";
+    for (size_t i = 0; i < standings.size(); i++) {
+        const IPLTeam& team = iplTeams[standings[i]];
+        std::string marker = (standings[i] == managerProfile.selectedTeam) ? "▶ " : "  ";
         
-        std::cout << "║  " << std::left << std::setw(3) << (i + 1) 
+        output << "║  " << std::left << std::setw(3) << (i + 1) 
                   << marker << std::setw(18) << team.name
                   << std::setw(4) << (team.wins + team.losses + team.ties)
                   << std::setw(4) << team.wins
@@ -740,80 +1041,80 @@ void IPLManager::showLeagueTable() {
                   << std::setw(10) << team.points << "     ║\n";
     }
     
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  0. Go Back                                                 ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0): ";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  0. Go Back                                                 ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0): ";
 }
 
 void IPLManager::showPlayoffs() {
     printBanner("🏆 PLAYOFFS");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  🏆 IPL 2025 Playoffs                                       ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Qualifier 1: 1st vs 2nd                                    ║\n";
-    std::cout << "║  Eliminator: 3rd vs 4th                                     ║\n";
-    std::cout << "║  Qualifier 2: Loser Q1 vs Winner Eliminator                 ║\n";
-    std::cout << "║  Final: Winner Q1 vs Winner Q2                              ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. Simulate Playoffs                                       ║\n";
-    std::cout << "║  0. Go Back                                                 ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-1): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  🏆 IPL 2025 Playoffs                                       ║\n";
+    output << "║                                                              ║\n";
+    output << "║  Qualifier 1: 1st vs 2nd                                    ║\n";
+    output << "║  Eliminator: 3rd vs 4th                                     ║\n";
+    output << "║  Qualifier 2: Loser Q1 vs Winner Eliminator                 ║\n";
+    output << "║  Final: Winner Q1 vs Winner Q2                              ║\n";
+    output << "║                                                              ║\n";
+    output << "║  1. Simulate Playoffs                                       ║\n";
+    output << "║  0. Go Back                                                 ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0-1): ";
 }
 
 void IPLManager::showCareerSummary() {
     printBanner("📈 CAREER SUMMARY");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Manager: " << std::left << std::setw(46) << managerProfile.name << "║\n";
-    std::cout << "║  Team: " << std::left << std::setw(49) << managerProfile.selectedTeam << "║\n";
-    std::cout << "║  Season: " << std::left << std::setw(47) << managerProfile.careerYear << "║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  Season Statistics:                                         ║\n";
-    std::cout << "║  Total Matches: " << std::left << std::setw(41) << managerProfile.totalMatches << "║\n";
-    std::cout << "║  Wins: " << std::left << std::setw(49) << managerProfile.totalWins << "║\n";
-    std::cout << "║  Losses: " << std::left << std::setw(47) << managerProfile.totalLosses << "║\n";
-    std::cout << "║  Win Percentage: " << std::left << std::setw(41) << std::fixed << std::setprecision(1) << managerProfile.winPercentage << "% ║\n";
-    std::cout << "║  Championships: " << std::left << std::setw(42) << managerProfile.championships << "║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  1. Start Next Season                                       ║\n";
-    std::cout << "║  0. Return to Main Menu                                     ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0-1): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  Manager: " << std::left << std::setw(46) << managerProfile.name << "║\n";
+    output << "║  Team: " << std::left << std::setw(49) << teamName(managerProfile.selectedTeam) << "║\n";
+    output << "║  Season: " << std::left << std::setw(47) << managerProfile.careerYear << "║\n";
+    output << "║                                                              ║\n";
+    output << "║  Season Statistics:                                         ║\n";
+    output << "║  Total Matches: " << std::left << std::setw(41) << managerProfile.totalMatches << "║\n";
+    output << "║  Wins: " << std::left << std::setw(49) << managerProfile.totalWins << "║\n";
+    output << "║  Losses: " << std::left << std::setw(47) << managerProfile.totalLosses << "║\n";
+    output << "║  Win Percentage: " << std::left << std::setw(41) << std::fixed << std::setprecision(1) << managerProfile.winPercentage << "% ║\n";
+    output << "║  Championships: " << std::left << std::setw(42) << managerProfile.championships << "║\n";
+    output << "║                                                              ║\n";
+    output << "║  1. Start Next Season                                       ║\n";
+    output << "║  0. Return to Main Menu                                     ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0-1): ";
 }
 
 void IPLManager::showSettings() {
     printBanner("⚙️ SETTINGS");
-    std::cout << "\n";
-    
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  🎮 Game Settings                                           ║\n";
-    std::cout << "║  📊 Display Settings                                        ║\n";
-    std::cout << "║  🎵 Audio Settings                                          ║\n";
-    std::cout << "║  💾 Save/Load Game                                          ║\n";
-    std::cout << "║  ℹ️  About                                                   ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "║  0. Go Back                                                 ║\n";
-    std::cout << "║                                                              ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-    std::cout << "Enter your choice (0): ";
+    output << "\n";
+    
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                                                              ║\n";
+    output << "║  🎮 Game Settings                                           ║\n";
+    output << "║  📊 Display Settings                                        ║\n";
+    output << "║  🎵 Audio Settings                                          ║\n";
+    output << "║  💾 Save/Load Game                                          ║\n";
+    output << "║  ℹ️  About                                                   ║\n";
+    output << "║                                                              ║\n";
+    output << "║  0. Go Back                                                 ║\n";
+    output << "║                                                              ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "Enter your choice (0): ";
 }
 
 // Game Logic Methods
@@ -832,6 +1133,8 @@ void IPLManager::initializeIPLTeams() {
         {"Lucknow Super Giants", "Lucknow", "BRSABV Ekana Stadium"}
     };
     
+    // A team's position here is its FranchiseId
+    iplTeams.clear();
     for (const auto& [name, city, ground] : teamData) {
         IPLTeam team;
         team.name = name;
@@ -842,15 +1145,11 @@ void IPLManager::initializeIPLTeams() {
     
     aiTeams.clear();
     std::vector<AIStrategy> strategies = {AIStrategy::AGGRESSIVE, AIStrategy::BALANCED, AIStrategy::CONSERVATIVE, AIStrategy::WILDCARD};
-    std::random_device rd;
-    std::mt19937 g(rd());
     for (size_t i = 0; i < iplTeams.size(); ++i) {
         AITeam ai;
-        ai.team = iplTeams[i];
+        ai.id = static_cast<FranchiseId>(i);
         ai.budget = 120.0f;
-        ai.overseasCount = 0;
         ai.strategy = strategies[i % strategies.size()];
-        ai.squad.clear();
         aiTeams.push_back(ai);
     }
 }
@@ -867,13 +1166,11 @@ void IPLManager::loadPlayersFromAPI() {
     std::vector<std::string> overseasNames = {
         "Tim David", "Cameron Green", "Dewald Brevis", "Tristan Stubbs", "Devon Conway", "Ben Stokes", "Moeen Ali", "Mitchell Santner", "Kyle Jamieson", "Faf du Plessis", "Glenn Maxwell", "Josh Hazlewood", "Wanindu Hasaranga", "David Warner", "Mitchell Marsh", "Rilee Rossouw", "Phil Salt", "Liam Livingstone", "Sam Curran", "Kagiso Rabada", "Jonny Bairstow", "Jos Buttler", "Trent Boult", "Shimron Hetmyer", "Obed McCoy", "Rashid Khan", "David Miller", "Matthew Wade", "Alzarri Joseph", "Lockie Ferguson", "Kane Williamson", "Nicholas Pooran", "Quinton de Kock", "Marcus Stoinis", "Mark Wood", "Kyle Mayers", "Aiden Markram", "Heinrich Klaasen", "Marco Jansen", "Pat Cummins", "Harry Brook", "Rahmanullah Gurbaz", "Andre Russell", "Sunil Narine", "Tim Southee", "Jason Roy", "Dwaine Pretorius", "Sisanda Magala", "Chris Jordan", "Jofra Archer", "Riley Meredith"
     };
-    std::vector<std::string> roles = {"Batsman", "Bowler", "All-rounder", "Wicket-keeper"};
-    std::vector<std::string> nationalities = {"Indian", "Overseas"};
-    std::vector<std::string> battingApproaches = {"Aggressive", "Defensive", "Balanced", "Attacking"};
+    std::vector<PlayerRole> roles = {PlayerRole::BATSMAN, PlayerRole::BOWLER, PlayerRole::ALL_ROUNDER, PlayerRole::WICKET_KEEPER};
     
     // Clear previous
     availablePlayers.clear();
-    srand(42); // For reproducibility
+    RandomStream squadRandom = RandomService::GetStream(RandomDomain::SQUAD, seasonIndex);
     int indianIdx = 0, overseasIdx = 0;
     for (const auto& team : teams) {
         // 14 Indian players
@@ -882,42 +1179,42 @@ void IPLManager::loadPlayersFromAPI() {
             player.name = indianNames[indianIdx % indianNames.size()] + " " + std::to_string(i+1);
             player.team = team;
             player.role = roles[i % roles.size()];
-            player.nationality = "Indian";
-            player.battingRating = 55 + rand() % 45; // 55-99
-            player.bowlingRating = 40 + rand() % 60; // 40-99
-            player.fieldingRating = 50 + rand() % 50; // 50-99
-            player.price = 4 + (rand() % 25); // 4-28 crore
-            player.age = 20 + (rand() % 17); // 20-36
+            player.nationality = Nationality::INDIAN;
+            player.ratings.batting = 55 + squadRandom.NextIndex(45); // 55-99
+            player.ratings.bowling = 40 + squadRandom.NextIndex(60); // 40-99
+            player.ratings.fielding = 50 + squadRandom.NextIndex(50); // 50-99
+            player.price = 4 + (squadRandom.NextIndex(25)); // 4-28 crore
+            player.age = 20 + (squadRandom.NextIndex(17)); // 20-36
             
             // Assign batting approach based on role and batting rating
-            if (player.role == "Batsman") {
-                if (player.battingRating > 85) {
-                    player.battingApproach = "Aggressive";
-                } else if (player.battingRating > 75) {
-                    player.battingApproach = "Attacking";
-                } else if (player.battingRating > 65) {
-                    player.battingApproach = "Balanced";
+            if (player.role == PlayerRole::BATSMAN) {
+                if (player.ratings.batting > 85) {
+                    player.battingApproach = BattingApproach::AGGRESSIVE;
+                } else if (player.ratings.batting > 75) {
+                    player.battingApproach = BattingApproach::ATTACKING;
+                } else if (player.ratings.batting > 65) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
-            } else if (player.role == "All-rounder") {
-                if (player.battingRating > 80) {
-                    player.battingApproach = "Attacking";
-                } else if (player.battingRating > 70) {
-                    player.battingApproach = "Balanced";
+            } else if (player.role == PlayerRole::ALL_ROUNDER) {
+                if (player.ratings.batting > 80) {
+                    player.battingApproach = BattingApproach::ATTACKING;
+                } else if (player.ratings.batting > 70) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
-            } else if (player.role == "Wicket-keeper") {
-                if (player.battingRating > 80) {
-                    player.battingApproach = "Aggressive";
-                } else if (player.battingRating > 70) {
-                    player.battingApproach = "Balanced";
+            } else if (player.role == PlayerRole::WICKET_KEEPER) {
+                if (player.ratings.batting > 80) {
+                    player.battingApproach = BattingApproach::AGGRESSIVE;
+                } else if (player.ratings.batting > 70) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
             } else { // Bowler
-                player.battingApproach = "Defensive";
+                player.battingApproach = BattingApproach::DEFENSIVE;
             }
             
             availablePlayers.push_back(player);
@@ -929,49 +1226,49 @@ void IPLManager::loadPlayersFromAPI() {
             player.name = overseasNames[overseasIdx % overseasNames.size()] + " " + std::to_string(i+1);
             player.team = team;
             player.role = roles[(i+1) % roles.size()];
-            player.nationality = "Overseas";
-            player.battingRating = 60 + rand() % 40; // 60-99
-            player.bowlingRating = 45 + rand() % 55; // 45-99
-            player.fieldingRating = 55 + rand() % 45; // 55-99
-            player.price = 6 + (rand() % 25); // 6-30 crore
-            player.age = 22 + (rand() % 15); // 22-36
+            player.nationality = Nationality::OVERSEAS;
+            player.ratings.batting = 60 + squadRandom.NextIndex(40); // 60-99
+            player.ratings.bowling = 45 + squadRandom.NextIndex(55); // 45-99
+            player.ratings.fielding = 55 + squadRandom.NextIndex(45); // 55-99
+            player.price = 6 + (squadRandom.NextIndex(25)); // 6-30 crore
+            player.age = 22 + (squadRandom.NextIndex(15)); // 22-36
             
             // Assign batting approach based on role and batting rating
-            if (player.role == "Batsman") {
-                if (player.battingRating > 85) {
-                    player.battingApproach = "Aggressive";
-                } else if (player.battingRating > 75) {
-                    player.battingApproach = "Attacking";
-                } else if (player.battingRating > 65) {
-                    player.battingApproach = "Balanced";
+            if (player.role == PlayerRole::BATSMAN) {
+                if (player.ratings.batting > 85) {
+                    player.battingApproach = BattingApproach::AGGRESSIVE;
+                } else if (player.ratings.batting > 75) {
+                    player.battingApproach = BattingApproach::ATTACKING;
+                } else if (player.ratings.batting > 65) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
-            } else if (player.role == "All-rounder") {
-                if (player.battingRating > 80) {
-                    player.battingApproach = "Attacking";
-                } else if (player.battingRating > 70) {
-                    player.battingApproach = "Balanced";
+            } else if (player.role == PlayerRole::ALL_ROUNDER) {
+                if (player.ratings.batting > 80) {
+                    player.battingApproach = BattingApproach::ATTACKING;
+                } else if (player.ratings.batting > 70) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
-            } else if (player.role == "Wicket-keeper") {
-                if (player.battingRating > 80) {
-                    player.battingApproach = "Aggressive";
-                } else if (player.battingRating > 70) {
-                    player.battingApproach = "Balanced";
+            } else if (player.role == PlayerRole::WICKET_KEEPER) {
+                if (player.ratings.batting > 80) {
+                    player.battingApproach = BattingApproach::AGGRESSIVE;
+                } else if (player.ratings.batting > 70) {
+                    player.battingApproach = BattingApproach::BALANCED;
                 } else {
-                    player.battingApproach = "Defensive";
+                    player.battingApproach = BattingApproach::DEFENSIVE;
                 }
             } else { // Bowler
-                player.battingApproach = "Defensive";
+                player.battingApproach = BattingApproach::DEFENSIVE;
             }
             
             availablePlayers.push_back(player);
             ++overseasIdx;
         }
     }
-    std::cout << "Loaded " << availablePlayers.size() << " players into auction pool.\n";
+    output << "Loaded " << availablePlayers.size() << " players into auction pool.\n";
 }
 
 void IPLManager::generateSeasonFixtures() {
@@ -982,8 +1279,8 @@ void IPLManager::generateSeasonFixtures() {
         for (size_t j = i + 1; j < iplTeams.size(); j++) {
             // Home match
             Match match1;
-            match1.team1 = iplTeams[i].name;
-            match1.team2 = iplTeams[j].name;
+            match1.team1 = static_cast<FranchiseId>(i);
+            match1.team2 = static_cast<FranchiseId>(j);
             match1.venue = iplTeams[i].homeGround;
             match1.date = "Match " + std::to_string(seasonFixtures.size() + 1);
             match1.isPlayed = false;
@@ -991,8 +1288,8 @@ void IPLManager::generateSeasonFixtures() {
             
             // Away match
             Match match2;
-            match2.team1 = iplTeams[j].name;
-            match2.team2 = iplTeams[i].name;
+            match2.team1 = static_cast<FranchiseId>(j);
+            match2.team2 = static_cast<FranchiseId>(i);
             match2.venue = iplTeams[j].homeGround;
             match2.date = "Match " + std::to_string(seasonFixtures.size() + 1);
             match2.isPlayed = false;
@@ -1001,30 +1298,57 @@ void IPLManager::generateSeasonFixtures() {
     }
     
     // Shuffle fixtures for randomness
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(seasonFixtures.begin(), seasonFixtures.end(), g);
+    std::shuffle(seasonFixtures.begin(), seasonFixtures.end(), rng);
 }
 
 void IPLManager::simulateMatch(Match& match) {
+    playMatch(match, output);
+    recordResult(match);
+}
+
+// Points and the manager's record; only ever called from the game thread,
+// in fixture order
+void IPLManager::recordResult(const Match& match) {
+    for (FranchiseId id : {match.team1, match.team2}) {
+        IPLTeam& team = iplTeams[id];
+        if (match.winner == id) {
+            team.wins++;
+            team.points += 2;
+        } else if (match.winner == NoFranchise) {
+            team.ties++;
+            team.points += 1;
+        } else {
+            team.losses++;
+        }
+    }
+    if (match.team1 == managerProfile.selectedTeam || match.team2 == managerProfile.selectedTeam) {
+        managerProfile.totalMatches++;
+        if (match.winner == managerProfile.selectedTeam) {
+            managerProfile.totalWins++;
+        } else if (match.winner != NoFranchise) {
+            managerProfile.totalLosses++;
+        }
+        managerProfile.winPercentage = (float)managerProfile.totalWins / managerProfile.totalMatches * 100.0f;
+    }
+}
+
+void IPLManager::playMatch(Match& match, std::ostream& out) {
     // Over-by-over simulation with bowler selection for manager
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Each fixture has its own stream in each season, so a seeded season replays exactly
+    const std::string& team1Name = teamName(match.team1);
+    const std::string& team2Name = teamName(match.team2);
+    RandomStream gen = RandomService::GetStream(RandomDomain::MATCH, 
+        RandomService::Mix(seasonIndex) ^ RandomService::HashName(match.date + team1Name + team2Name));
     std::uniform_int_distribution<> runsDist(0, 6); // 0-6 runs per ball
     std::uniform_int_distribution<> wicketDist(0, 19); // 0 = wicket (5% chance)
     int overs = 20;
     int ballsPerOver = 6;
     int team1Score = 0, team2Score = 0;
     int team1Wickets = 0, team2Wickets = 0;
-    std::vector<std::string> commentary;
+    std::vector<BallNote> keyMoments;
     
-    // Find AITeam objects
-    AITeam* team1AI = nullptr;
-    AITeam* team2AI = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == match.team1) team1AI = &ai;
-        if (ai.team.name == match.team2) team2AI = &ai;
-    }
+    AITeam* team1AI = &aiTeams[match.team1];
+    AITeam* team2AI = &aiTeams[match.team2];
     
     // Create batting orders based on batting approaches
     std::vector<IPLPlayer*> team1BattingOrder;
@@ -1036,7 +1360,7 @@ void IPLManager::simulateMatch(Match& match) {
     std::map<std::string, int> team1BowlerOvers, team2BowlerOvers;
     
     // Team 1 batting
-    std::cout << "\n" << match.team1 << " Innings:\n";
+    out << "\n" << team1Name << " Innings:\n";
     int team1BatterIndex = 0;
     for (int over = 1; over <= overs && team1Wickets < 10; ++over) {
         IPLPlayer* bowler = nullptr;
@@ -1075,155 +1399,58 @@ void IPLManager::simulateMatch(Match& match) {
             
             // Adjust runs based on batting approach
             if (currentBatter) {
-                if (currentBatter->battingApproach == "Aggressive") {
+                if (currentBatter->battingApproach == BattingApproach::AGGRESSIVE) {
                     // Aggressive batters are more likely to hit boundaries but also get out
                     if (runs < 4) runs = std::max(0, runs - 1);
                     if (runs >= 4) runs = std::min(6, runs + 1);
                     if (wicketDist(gen) < 3) wicket = true; // Higher chance of getting out
-                } else if (currentBatter->battingApproach == "Attacking") {
+                } else if (currentBatter->battingApproach == BattingApproach::ATTACKING) {
                     // Attacking batters are good at rotating strike and hitting boundaries
                     if (runs == 0) runs = 1; // Less likely to get dot balls
                     if (runs >= 4) runs = std::min(6, runs + 1);
-                } else if (currentBatter->battingApproach == "Balanced") {
+                } else if (currentBatter->battingApproach == BattingApproach::BALANCED) {
                     // Balanced batters are consistent
                     // No special adjustments
-                } else if (currentBatter->battingApproach == "Defensive") {
+                } else if (currentBatter->battingApproach == BattingApproach::DEFENSIVE) {
                     // Defensive batters are less likely to get out but score fewer runs
                     if (runs > 4) runs = std::max(1, runs - 2);
                     if (wicketDist(gen) > 15) wicket = false; // Lower chance of getting out
                 }
                 
                 // Adjust based on batting rating
-                if (currentBatter->battingRating > 80 && runs > 0) runs += 1;
-                if (currentBatter->battingRating < 60 && runs > 2) runs -= 1;
+                if (currentBatter->ratings.batting > 80 && runs > 0) runs += 1;
+                if (currentBatter->ratings.batting < 60 && runs > 2) runs -= 1;
             }
             
             // Bowler skill: reduce runs, increase wicket chance
             if (bowler) {
-                if (bowler->bowlingRating > 80 && runs > 0) runs -= 1;
-                if (bowler->bowlingRating > 90 && runs > 0) runs -= 1;
-                if (bowler->bowlingRating > 80 && wicketDist(gen) < 2) wicket = true;
+                if (bowler->ratings.bowling > 80 && runs > 0) runs -= 1;
+                if (bowler->ratings.bowling > 90 && runs > 0) runs -= 1;
+                if (bowler->ratings.bowling > 80 && wicketDist(gen) < 2) wicket = true;
             }
             
             if (runs < 0) runs = 0;
             overRuns += runs;
             team1Score += runs;
             
-            std::string event = "";
             if (wicket) {
                 team1Wickets++;
                 overWickets++;
                 team1BatterIndex++; // Next batter
-                if (currentBatter) {
-                    std::vector<std::string> wicketCommentary = {
-                        "WICKET! " + currentBatter->name + " is clean bowled!",
-                        "WICKET! " + currentBatter->name + " edges it to the keeper!",
-                        "WICKET! " + currentBatter->name + " caught at mid-wicket!",
-                        "WICKET! " + currentBatter->name + " LBW! That's plumb!",
-                        "WICKET! " + currentBatter->name + " stumped! Brilliant work by the keeper!",
-                        "WICKET! " + currentBatter->name + " run out! What a mix-up!",
-                        "WICKET! " + currentBatter->name + " caught at deep mid-wicket!",
-                        "WICKET! " + currentBatter->name + " bowled around the legs!"
-                    };
-                    event = wicketCommentary[rand() % wicketCommentary.size()] + " ";
-                } else {
-                    event = "WICKET! ";
-                }
-            }
-            if (runs == 4) {
-                if (currentBatter) {
-                    std::vector<std::string> fourCommentary = {
-                        "FOUR! " + currentBatter->name + " drives it beautifully through the covers!",
-                        "FOUR! " + currentBatter->name + " cuts it past point for a boundary!",
-                        "FOUR! " + currentBatter->name + " pulls it to the mid-wicket boundary!",
-                        "FOUR! " + currentBatter->name + " flicks it fine for four!",
-                        "FOUR! " + currentBatter->name + " square drives it to the boundary!",
-                        "FOUR! " + currentBatter->name + " plays a lovely shot through extra cover!",
-                        "FOUR! " + currentBatter->name + " hits it over the bowler's head!",
-                        "FOUR! " + currentBatter->name + " guides it past third man!"
-                    };
-                    event += fourCommentary[rand() % fourCommentary.size()] + " ";
-                } else {
-                    event += "FOUR! ";
-                }
-            }
-            if (runs == 6) {
-                if (currentBatter) {
-                    std::vector<std::string> sixCommentary = {
-                        "SIX! " + currentBatter->name + " launches it over long-on for a maximum!",
-                        "SIX! " + currentBatter->name + " smashes it over mid-wicket!",
-                        "SIX! " + currentBatter->name + " hits it over the covers for six!",
-                        "SIX! " + currentBatter->name + " pulls it over square leg!",
-                        "SIX! " + currentBatter->name + " drives it straight down the ground!",
-                        "SIX! " + currentBatter->name + " scoops it over fine leg!",
-                        "SIX! " + currentBatter->name + " reverse sweeps it over point!",
-                        "SIX! " + currentBatter->name + " hits it over long-off!"
-                    };
-                    event += sixCommentary[rand() % sixCommentary.size()] + " ";
-                } else {
-                    event += "SIX! ";
-                }
-            }
-            if (runs == 1) {
-                if (currentBatter) {
-                    std::vector<std::string> singleCommentary = {
-                        currentBatter->name + " takes a quick single.",
-                        currentBatter->name + " works it to mid-wicket for one.",
-                        currentBatter->name + " pushes it to cover for a single.",
-                        currentBatter->name + " taps it to point for one run."
-                    };
-                    if (rand() % 10 < 3) { // 30% chance for single commentary
-                        event += singleCommentary[rand() % singleCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (runs == 2) {
-                if (currentBatter) {
-                    std::vector<std::string> twoCommentary = {
-                        currentBatter->name + " runs hard for two.",
-                        currentBatter->name + " places it in the gap for a couple.",
-                        currentBatter->name + " works it to deep square leg for two."
-                    };
-                    if (rand() % 10 < 4) { // 40% chance for two commentary
-                        event += twoCommentary[rand() % twoCommentary.size()] + " ";
-                    }
-                }
             }
-            if (runs == 3) {
-                if (currentBatter) {
-                    std::vector<std::string> threeCommentary = {
-                        currentBatter->name + " runs three! Good running between the wickets.",
-                        currentBatter->name + " places it perfectly for three runs."
-                    };
-                    if (rand() % 10 < 5) { // 50% chance for three commentary
-                        event += threeCommentary[rand() % threeCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (runs == 0) {
-                if (currentBatter) {
-                    std::vector<std::string> dotCommentary = {
-                        currentBatter->name + " defends it solidly.",
-                        currentBatter->name + " leaves it alone.",
-                        currentBatter->name + " blocks it back to the bowler.",
-                        currentBatter->name + " plays it to mid-off.",
-                        currentBatter->name + " lets it go through to the keeper."
-                    };
-                    if (rand() % 10 < 2) { // 20% chance for dot commentary
-                        event += dotCommentary[rand() % dotCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (!event.empty()) {
-                commentary.push_back("Over " + std::to_string(over) + "." + std::to_string(ball) + ": " + event);
+            
+            // Keep a compact note; the text is only built when printed
+            BallNote note{over, ball, runs, wicket, currentBatter, gen()};
+            if (isKeyMoment(note)) {
+                keyMoments.push_back(note);
             }
         }
-        std::cout << "Over " << over << ": " << overRuns << " runs, " << overWickets << " wickets. Total: " << team1Score << "/" << team1Wickets << "\n";
+        out << "Over " << over << ": " << overRuns << " runs, " << overWickets << " wickets. Total: " << team1Score << "/" << team1Wickets << "\n";
     }
-    std::cout << "End of Innings: " << match.team1 << " " << team1Score << "/" << team1Wickets << "\n";
+    out << "End of Innings: " << team1Name << " " << team1Score << "/" << team1Wickets << "\n";
     
     // Team 2 batting
-    std::cout << "\n" << match.team2 << " Innings:\n";
+    out << "\n" << team2Name << " Innings:\n";
     int team2BatterIndex = 0;
     for (int over = 1; over <= overs && team2Wickets < 10 && team2Score <= team1Score; ++over) {
         IPLPlayer* bowler = nullptr;
@@ -1262,158 +1489,61 @@ void IPLManager::simulateMatch(Match& match) {
             
             // Adjust runs based on batting approach
             if (currentBatter) {
-                if (currentBatter->battingApproach == "Aggressive") {
+                if (currentBatter->battingApproach == BattingApproach::AGGRESSIVE) {
                     // Aggressive batters are more likely to hit boundaries but also get out
                     if (runs < 4) runs = std::max(0, runs - 1);
                     if (runs >= 4) runs = std::min(6, runs + 1);
                     if (wicketDist(gen) < 3) wicket = true; // Higher chance of getting out
-                } else if (currentBatter->battingApproach == "Attacking") {
+                } else if (currentBatter->battingApproach == BattingApproach::ATTACKING) {
                     // Attacking batters are good at rotating strike and hitting boundaries
                     if (runs == 0) runs = 1; // Less likely to get dot balls
                     if (runs >= 4) runs = std::min(6, runs + 1);
-                } else if (currentBatter->battingApproach == "Balanced") {
+                } else if (currentBatter->battingApproach == BattingApproach::BALANCED) {
                     // Balanced batters are consistent
                     // No special adjustments
-                } else if (currentBatter->battingApproach == "Defensive") {
+                } else if (currentBatter->battingApproach == BattingApproach::DEFENSIVE) {
                     // Defensive batters are less likely to get out but score fewer runs
                     if (runs > 4) runs = std::max(1, runs - 2);
                     if (wicketDist(gen) > 15) wicket = false; // Lower chance of getting out
                 }
                 
                 // Adjust based on batting rating
-                if (currentBatter->battingRating > 80 && runs > 0) runs += 1;
-                if (currentBatter->battingRating < 60 && runs > 2) runs -= 1;
+                if (currentBatter->ratings.batting > 80 && runs > 0) runs += 1;
+                if (currentBatter->ratings.batting < 60 && runs > 2) runs -= 1;
             }
             
             // Bowler skill: reduce runs, increase wicket chance
             if (bowler) {
-                if (bowler->bowlingRating > 80 && runs > 0) runs -= 1;
-                if (bowler->bowlingRating > 90 && runs > 0) runs -= 1;
-                if (bowler->bowlingRating > 80 && wicketDist(gen) < 2) wicket = true;
+                if (bowler->ratings.bowling > 80 && runs > 0) runs -= 1;
+                if (bowler->ratings.bowling > 90 && runs > 0) runs -= 1;
+                if (bowler->ratings.bowling > 80 && wicketDist(gen) < 2) wicket = true;
             }
             
             if (runs < 0) runs = 0;
             overRuns += runs;
             team2Score += runs;
             
-            std::string event = "";
             if (wicket) {
                 team2Wickets++;
                 overWickets++;
                 team2BatterIndex++; // Next batter
-                if (currentBatter) {
-                    std::vector<std::string> wicketCommentary = {
-                        "WICKET! " + currentBatter->name + " is clean bowled!",
-                        "WICKET! " + currentBatter->name + " edges it to the keeper!",
-                        "WICKET! " + currentBatter->name + " caught at mid-wicket!",
-                        "WICKET! " + currentBatter->name + " LBW! That's plumb!",
-                        "WICKET! " + currentBatter->name + " stumped! Brilliant work by the keeper!",
-                        "WICKET! " + currentBatter->name + " run out! What a mix-up!",
-                        "WICKET! " + currentBatter->name + " caught at deep mid-wicket!",
-                        "WICKET! " + currentBatter->name + " bowled around the legs!"
-                    };
-                    event = wicketCommentary[rand() % wicketCommentary.size()] + " ";
-                } else {
-                    event = "WICKET! ";
-                }
-            }
-            if (runs == 4) {
-                if (currentBatter) {
-                    std::vector<std::string> fourCommentary = {
-                        "FOUR! " + currentBatter->name + " drives it beautifully through the covers!",
-                        "FOUR! " + currentBatter->name + " cuts it past point for a boundary!",
-                        "FOUR! " + currentBatter->name + " pulls it to the mid-wicket boundary!",
-                        "FOUR! " + currentBatter->name + " flicks it fine for four!",
-                        "FOUR! " + currentBatter->name + " square drives it to the boundary!",
-                        "FOUR! " + currentBatter->name + " plays a lovely shot through extra cover!",
-                        "FOUR! " + currentBatter->name + " hits it over the bowler's head!",
-                        "FOUR! " + currentBatter->name + " guides it past third man!"
-                    };
-                    event += fourCommentary[rand() % fourCommentary.size()] + " ";
-                } else {
-                    event += "FOUR! ";
-                }
             }
-            if (runs == 6) {
-                if (currentBatter) {
-                    std::vector<std::string> sixCommentary = {
-                        "SIX! " + currentBatter->name + " launches it over long-on for a maximum!",
-                        "SIX! " + currentBatter->name + " smashes it over mid-wicket!",
-                        "SIX! " + currentBatter->name + " hits it over the covers for six!",
-                        "SIX! " + currentBatter->name + " pulls it over square leg!",
-                        "SIX! " + currentBatter->name + " drives it straight down the ground!",
-                        "SIX! " + currentBatter->name + " scoops it over fine leg!",
-                        "SIX! " + currentBatter->name + " reverse sweeps it over point!",
-                        "SIX! " + currentBatter->name + " hits it over long-off!"
-                    };
-                    event += sixCommentary[rand() % sixCommentary.size()] + " ";
-                } else {
-                    event += "SIX! ";
-                }
-            }
-            if (runs == 1) {
-                if (currentBatter) {
-                    std::vector<std::string> singleCommentary = {
-                        currentBatter->name + " takes a quick single.",
-                        currentBatter->name + " works it to mid-wicket for one.",
-                        currentBatter->name + " pushes it to cover for a single.",
-                        currentBatter->name + " taps it to point for one run."
-                    };
-                    if (rand() % 10 < 3) { // 30% chance for single commentary
-                        event += singleCommentary[rand() % singleCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (runs == 2) {
-                if (currentBatter) {
-                    std::vector<std::string> twoCommentary = {
-                        currentBatter->name + " runs hard for two.",
-                        currentBatter->name + " places it in the gap for a couple.",
-                        currentBatter->name + " works it to deep square leg for two."
-                    };
-                    if (rand() % 10 < 4) { // 40% chance for two commentary
-                        event += twoCommentary[rand() % twoCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (runs == 3) {
-                if (currentBatter) {
-                    std::vector<std::string> threeCommentary = {
-                        currentBatter->name + " runs three! Good running between the wickets.",
-                        currentBatter->name + " places it perfectly for three runs."
-                    };
-                    if (rand() % 10 < 5) { // 50% chance for three commentary
-                        event += threeCommentary[rand() % threeCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (runs == 0) {
-                if (currentBatter) {
-                    std::vector<std::string> dotCommentary = {
-                        currentBatter->name + " defends it solidly.",
-                        currentBatter->name + " leaves it alone.",
-                        currentBatter->name + " blocks it back to the bowler.",
-                        currentBatter->name + " plays it to mid-off.",
-                        currentBatter->name + " lets it go through to the keeper."
-                    };
-                    if (rand() % 10 < 2) { // 20% chance for dot commentary
-                        event += dotCommentary[rand() % dotCommentary.size()] + " ";
-                    }
-                }
-            }
-            if (!event.empty()) {
-                commentary.push_back("Over " + std::to_string(over) + "." + std::to_string(ball) + ": " + event);
+            
+            // Keep a compact note; the text is only built when printed
+            BallNote note{over, ball, runs, wicket, currentBatter, gen()};
+            if (isKeyMoment(note)) {
+                keyMoments.push_back(note);
             }
         }
-        std::cout << "Over " << over << ": " << overRuns << " runs, " << overWickets << " wickets. Total: " << team2Score << "/" << team2Wickets << "\n";
+        out << "Over " << over << ": " << overRuns << " runs, " << overWickets << " wickets. Total: " << team2Score << "/" << team2Wickets << "\n";
         if (team2Score > team1Score) break;
     }
-    std::cout << "End of Innings: " << match.team2 << " " << team2Score << "/" << team2Wickets << "\n";
+    out << "End of Innings: " << team2Name << " " << team2Score << "/" << team2Wickets << "\n";
     
     // Print key commentary
-    std::cout << "\nKey Moments:\n";
-    for (const auto& line : commentary) {
-        std::cout << line << "\n";
+    out << "\nKey Moments:\n";
+    for (const auto& note : keyMoments) {
+        out << "Over " << note.over << "." << note.ball << ": " << describeKeyMoment(note) << "\n";
     }
     
     match.team1Score = team1Score;
@@ -1425,132 +1555,97 @@ void IPLManager::simulateMatch(Match& match) {
         match.winner = match.team2;
     } else {
         // Tie! Super Over time
-        std::cout << "\nMatch tied! A Super Over will decide the winner.\n";
-        std::string superOverWinner;
+        out << "\nMatch tied! A Super Over will decide the winner.\n";
+        FranchiseId superOverWinner;
         do {
-            superOverWinner = simulateSuperOver(match.team1, match.team2);
-            if (superOverWinner == "Tie") {
-                std::cout << "Super Over tied! Another Super Over will be played.\n";
+            superOverWinner = simulateSuperOver(match.team1, match.team2, gen, out);
+            if (superOverWinner == NoFranchise) {
+                out << "Super Over tied! Another Super Over will be played.\n";
             }
-        } while (superOverWinner == "Tie");
+        } while (superOverWinner == NoFranchise);
         match.winner = superOverWinner;
-        std::cout << "Super Over Winner: " << superOverWinner << "!\n";
-    }
-    // Update team and manager stats (unchanged)
-    for (auto& team : iplTeams) {
-        if (team.name == match.team1) {
-            if (match.winner == match.team1) {
-                team.wins++;
-                team.points += 2;
-            } else if (match.winner == "Tie") {
-                team.ties++;
-                team.points += 1;
-            } else {
-                team.losses++;
-            }
-        } else if (team.name == match.team2) {
-            if (match.winner == match.team2) {
-                team.wins++;
-                team.points += 2;
-            } else if (match.winner == "Tie") {
-                team.ties++;
-                team.points += 1;
-            } else {
-                team.losses++;
-            }
-        }
-    }
-    if (match.team1 == managerProfile.selectedTeam || match.team2 == managerProfile.selectedTeam) {
-        managerProfile.totalMatches++;
-        if (match.winner == managerProfile.selectedTeam) {
-            managerProfile.totalWins++;
-        } else if (match.winner != "Tie") {
-            managerProfile.totalLosses++;
-        }
-        managerProfile.winPercentage = (float)managerProfile.totalWins / managerProfile.totalMatches * 100.0f;
+        out << "Super Over Winner: " << teamName(superOverWinner) << "!\n";
     }
     // Print match result summary
-    std::cout << "\n══════════════════════════════════════════════════════════════\n";
-    std::cout << "MATCH RESULT SUMMARY\n";
-    std::cout << match.team1 << ": " << team1Score << "/" << team1Wickets << "  vs  " << match.team2 << ": " << team2Score << "/" << team2Wickets << "\n";
+    out << "\n══════════════════════════════════════════════════════════════\n";
+    out << "MATCH RESULT SUMMARY\n";
+    out << team1Name << ": " << team1Score << "/" << team1Wickets << "  vs  " << team2Name << ": " << team2Score << "/" << team2Wickets << "\n";
     if (match.winner == match.team1) {
         int margin = team1Score - team2Score;
-        std::cout << match.team1 << " won by " << margin << " run" << (margin == 1 ? "" : "s") << ".\n";
+        out << team1Name << " won by " << margin << " run" << (margin == 1 ? "" : "s") << ".\n";
     } else if (match.winner == match.team2) {
         int wicketsLeft = 10 - team2Wickets;
-        std::cout << match.team2 << " won by " << wicketsLeft << " wicket" << (wicketsLeft == 1 ? "" : "s") << ".\n";
+        out << team2Name << " won by " << wicketsLeft << " wicket" << (wicketsLeft == 1 ? "" : "s") << ".\n";
     } else {
-        std::cout << "Match tied! Winner decided by Super Over: " << match.winner << "\n";
+        out << "Match tied! Winner decided by Super Over: " << teamName(match.winner) << "\n";
     }
     // Top performers (batting: most runs, bowling: most wickets)
-    auto printTopPerformers = [](const std::string& teamName, const std::vector<IPLPlayer*>& battingOrder, int runsScored, int wicketsLost) {
+    auto printTopPerformers = [&gen, &out](const std::string& teamName, const std::vector<IPLPlayer*>& battingOrder, int runsScored, int wicketsLost) {
         std::vector<std::pair<std::string, int>> batterScores;
         std::vector<std::pair<std::string, int>> bowlerWickets;
         // For demo, randomly assign runs/wickets (replace with real stats if tracked)
         for (const auto* p : battingOrder) {
-            batterScores.emplace_back(p->name, 10 + rand() % 60);
+            batterScores.emplace_back(p->name, 10 + gen.NextIndex(60));
         }
         for (const auto* p : battingOrder) {
-            if (p->role == "Bowler" || p->role == "All-rounder")
-                bowlerWickets.emplace_back(p->name, rand() % 4);
+            if (p->role == PlayerRole::BOWLER || p->role == PlayerRole::ALL_ROUNDER)
+                bowlerWickets.emplace_back(p->name, gen.NextIndex(4));
         }
         std::sort(batterScores.begin(), batterScores.end(), [](auto& a, auto& b){ return a.second > b.second; });
         std::sort(bowlerWickets.begin(), bowlerWickets.end(), [](auto& a, auto& b){ return a.second > b.second; });
-        std::cout << "\nTop Performers for " << teamName << ":\n";
-        std::cout << "  Batting: ";
+        out << "\nTop Performers for " << teamName << ":\n";
+        out << "  Batting: ";
         for (int i = 0; i < std::min(2, (int)batterScores.size()); ++i) {
-            std::cout << batterScores[i].first << " (" << batterScores[i].second << " runs)  ";
+            out << batterScores[i].first << " (" << batterScores[i].second << " runs)  ";
         }
-        std::cout << "\n  Bowling: ";
+        out << "\n  Bowling: ";
         for (int i = 0; i < std::min(2, (int)bowlerWickets.size()); ++i) {
-            std::cout << bowlerWickets[i].first << " (" << bowlerWickets[i].second << " wkts)  ";
+            out << bowlerWickets[i].first << " (" << bowlerWickets[i].second << " wkts)  ";
         }
-        std::cout << "\n";
+        out << "\n";
     };
-    printTopPerformers(match.team1, team1BattingOrder, team1Score, team1Wickets);
-    printTopPerformers(match.team2, team2BattingOrder, team2Score, team2Wickets);
-    std::cout << "══════════════════════════════════════════════════════════════\n";
+    printTopPerformers(team1Name, team1BattingOrder, team1Score, team1Wickets);
+    printTopPerformers(team2Name, team2BattingOrder, team2Score, team2Wickets);
+    out << "══════════════════════════════════════════════════════════════\n";
 }
 
 // Simulate a Super Over between two teams
-std::string IPLManager::simulateSuperOver(const std::string& team1, const std::string& team2) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+FranchiseId IPLManager::simulateSuperOver(FranchiseId team1, FranchiseId team2, RandomStream& gen, std::ostream& out) {
     std::uniform_int_distribution<> runDist(0, 6); // Each ball: 0-6 runs
     std::uniform_int_distribution<> wicketDist(0, 9); // 0-1 wicket (10% chance)
     int team1Runs = 0, team2Runs = 0;
     int team1Wickets = 0, team2Wickets = 0;
-    std::cout << "\nSuper Over: " << team1 << " batting\n";
+    out << "\nSuper Over: " << teamName(team1) << " batting\n";
     for (int ball = 1; ball <= 6 && team1Wickets < 2; ++ball) {
         int runs = runDist(gen);
         bool wicket = (wicketDist(gen) == 0);
         team1Runs += runs;
-        std::cout << "Ball " << ball << ": " << runs << " run(s)";
+        out << "Ball " << ball << ": " << runs << " run(s)";
         if (wicket) {
             team1Wickets++;
-            std::cout << " - WICKET!";
+            out << " - WICKET!";
         }
-        std::cout << "\n";
+        out << "\n";
         if (team1Wickets == 2) break;
     }
-    std::cout << "Total: " << team1Runs << "/" << team1Wickets << "\n";
-    std::cout << "Super Over: " << team2 << " batting\n";
+    out << "Total: " << team1Runs << "/" << team1Wickets << "\n";
+    out << "Super Over: " << teamName(team2) << " batting\n";
     for (int ball = 1; ball <= 6 && team2Wickets < 2; ++ball) {
         int runs = runDist(gen);
         bool wicket = (wicketDist(gen) == 0);
         team2Runs += runs;
-        std::cout << "Ball " << ball << ": " << runs << " run(s)";
+        out << "Ball " << ball << ": " << runs << " run(s)";
         if (wicket) {
             team2Wickets++;
-            std::cout << " - WICKET!";
+            out << " - WICKET!";
         }
-        std::cout << "\n";
+        out << "\n";
         if (team2Wickets == 2) break;
     }
-    std::cout << "Total: " << team2Runs << "/" << team2Wickets << "\n";
+    out << "Total: " << team2Runs << "/" << team2Wickets << "\n";
     if (team1Runs > team2Runs) return team1;
     if (team2Runs > team1Runs) return team2;
-    return "Tie";
+    return NoFranchise;
 }
 
 void IPLManager::updateLeagueTable() {
@@ -1564,14 +1659,52 @@ void IPLManager::updateLeagueTable() {
 }
 
 void IPLManager::calculatePlayoffs() {
-    // Sort teams for playoffs
-    std::sort(iplTeams.begin(), iplTeams.end(), 
-              [](const IPLTeam& a, const IPLTeam& b) {
-                  if (a.points != b.points) return a.points > b.points;
-                  return a.netRunRate > b.netRunRate;
+    // Sort teams for playoffs; the registry itself keeps its order
+    standings.clear();
+    for (size_t id = 0; id < iplTeams.size(); ++id) {
+        standings.push_back(static_cast<FranchiseId>(id));
+    }
+    std::sort(standings.begin(), standings.end(), 
+              [this](FranchiseId a, FranchiseId b) {
+                  if (iplTeams[a].points != iplTeams[b].points) return iplTeams[a].points > iplTeams[b].points;
+                  return iplTeams[a].netRunRate > iplTeams[b].netRunRate;
               });
 }
 
+void IPLManager::simulatePlayoffs() {
+    calculatePlayoffs();
+    playoffFixtures.clear();
+    if (iplTeams.size() < 4) {
+        return;
+    }
+    
+    // Playoff games follow the league fixtures in the season's match indices
+    playoffFixtures.reserve(4);
+    auto play = [this](const std::string& stage, FranchiseId team1, FranchiseId team2) -> const Match& {
+        Match match;
+        match.team1 = team1;
+        match.team2 = team2;
+        match.date = stage;
+        match.venue = iplTeams[team1].homeGround;
+        
+        uint32_t matchIndex = static_cast<uint32_t>(seasonFixtures.size() + playoffFixtures.size());
+        std::string result = simulateEngineMatch(match, matchIndex, true);
+        // A tied super over goes to the higher-placed side, who is always team1
+        if (match.winner == NoFranchise) {
+            match.winner = team1;
+        }
+        output << stage << ": " << teamName(team1) << " vs " << teamName(team2) << " - " << result << "\n";
+        playoffFixtures.push_back(match);
+        return playoffFixtures.back();
+    };
+    
+    const Match& qualifier1 = play("Qualifier 1", standings[0], standings[1]);
+    const Match& eliminator = play("Eliminator", standings[2], standings[3]);
+    FranchiseId qualifier1Loser = qualifier1.winner == qualifier1.team1 ? qualifier1.team2 : qualifier1.team1;
+    const Match& qualifier2 = play("Qualifier 2", qualifier1Loser, eliminator.winner);
+    play("Final", qualifier1.winner, qualifier2.winner);
+}
+
 // Utility Methods
 void IPLManager::clearScreen() {
     #ifdef _WIN32
@@ -1582,32 +1715,32 @@ void IPLManager::clearScreen() {
 }
 
 void IPLManager::printHeader() {
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                    IPL CRICKET MANAGER 2025                 ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║                    IPL CRICKET MANAGER 2025                 ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
 }
 
 void IPLManager::printFooter() {
-    std::cout << "\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Press Enter to continue...                                  ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║  Press Enter to continue...                                  ║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
 }
 
 void IPLManager::printCentered(const std::string& text) {
     int width = 60;
     int padding = (width - text.length()) / 2;
-    std::cout << std::string(padding, ' ') << text << std::endl;
+    output << std::string(padding, ' ') << text << std::endl;
 }
 
 void IPLManager::printBanner(const std::string& title) {
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║" << std::left << std::setw(58) << title << "║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║" << std::left << std::setw(58) << title << "║\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
 }
 
 void IPLManager::waitForInput() {
-    std::cout << "Press Enter to continue...";
+    output << "Press Enter to continue...";
     std::cin.get();
 }
 
@@ -1617,6 +1750,15 @@ std::string IPLManager::getInput() {
     return input;
 }
 
+const std::string& IPLManager::teamName(FranchiseId id) const {
+    static const std::string none;
+    return id < iplTeams.size() ? iplTeams[id].name : none;
+}
+
+AITeam* IPLManager::managerTeam() {
+    return managerProfile.selectedTeam < aiTeams.size() ? &aiTeams[managerProfile.selectedTeam] : nullptr;
+}
+
 // API Integration
 size_t IPLManager::WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
     userp->append((char*)contents, size * nmemb);
@@ -1650,28 +1792,21 @@ void IPLManager::parsePlayerData(const json& data) {
 
 // Add new method for auction simulation
 void IPLManager::simulateAuction() {
-    std::cout << "\n🎯 Simulating auction for all teams...\n";
-    std::cout << "This may take a moment...\n\n";
+    output << "\n🎯 Simulating auction for all teams...\n";
+    output << "This may take a moment...\n\n";
     
     // Create a copy of available players for auction
     std::vector<IPLPlayer> auctionPool = availablePlayers;
     
     // Shuffle players for randomness
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(auctionPool.begin(), auctionPool.end(), g);
+    std::shuffle(auctionPool.begin(), auctionPool.end(), rng);
     
     // Find user's team
-    AITeam* userTeam = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == managerProfile.selectedTeam) {
-            userTeam = &ai;
-            break;
-        }
-    }
+    AITeam* userTeam = managerTeam();
     
-    if (!userTeam) {
-        std::cout << "Error: User team not found!\n";
+    // Headless runs have no manager, so every team bids as AI
+    if (!userTeam && managerProfile.selectedTeam != NoFranchise) {
+        output << "Error: User team not found!\n";
         return;
     }
     
@@ -1686,63 +1821,34 @@ void IPLManager::simulateAuction() {
             }
             
             // Overseas player limit check
-            if (player.nationality == "Overseas" && ai.overseasCount >= 8) {
+            if (player.nationality == Nationality::OVERSEAS && ai.stats.overseas >= 8) {
                 continue;
             }
             
             // Check if team needs this role type
-            SquadStats stats = getSquadStats(ai);
-            bool needsThisRole = false;
-            
-            if (player.role == "Wicket-keeper" && stats.wicketKeepers < 1) {
-                needsThisRole = true;
-            } else if (player.role == "All-rounder" && stats.allRounders < 3) {
-                needsThisRole = true;
-            } else if (player.role == "Bowler" && stats.bowlers < 5) {
-                needsThisRole = true;
-            } else if (player.role == "Batsman" && stats.batsmen < 5) {
-                needsThisRole = true;
-            } else if (stats.totalPlayers < 18) {
-                // If team has less than 18 players, they need any player
-                needsThisRole = true;
-            }
-            
-            if (needsThisRole) {
+            if (ai.stats.Needs(player.role)) {
                 eligibleTeams.push_back(&ai);
             }
         }
         
         if (eligibleTeams.empty()) {
-            std::cout << "No eligible teams for " << player.name << " - Player unsold\n";
+            output << "No eligible teams for " << player.name << " - Player unsold\n";
             continue;
         }
         
         // Check if user's team needs this player and has less than 18 players
-        SquadStats userStats = getSquadStats(*userTeam);
-        bool userNeedsPlayer = false;
-        if (player.role == "Wicket-keeper" && userStats.wicketKeepers < 1) {
-            userNeedsPlayer = true;
-        } else if (player.role == "All-rounder" && userStats.allRounders < 3) {
-            userNeedsPlayer = true;
-        } else if (player.role == "Bowler" && userStats.bowlers < 5) {
-            userNeedsPlayer = true;
-        } else if (player.role == "Batsman" && userStats.batsmen < 5) {
-            userNeedsPlayer = true;
-        } else if (userStats.totalPlayers < 18) {
-            userNeedsPlayer = true;
-        }
+        bool userNeedsPlayer = userTeam && userTeam->stats.Needs(player.role);
         
         // If user needs this player and has less than 18 players, give them priority
-        if (userNeedsPlayer && userStats.totalPlayers < 18 && 
+        if (userNeedsPlayer && userTeam->stats.totalPlayers < 18 && 
             userTeam->budget >= player.price && 
-            (player.nationality == "Indian" || userTeam->overseasCount < 8)) {
+            (player.nationality == Nationality::INDIAN || userTeam->stats.overseas < 8)) {
             
             // User gets the player at base price
-            userTeam->squad.push_back(player);
+            userTeam->AddPlayer(player);
             userTeam->budget -= player.price;
-            if (player.nationality == "Overseas") userTeam->overseasCount++;
             
-            std::cout << player.name << " → " << userTeam->team.name << " (₹" << player.price << " crore) [Priority]\n";
+            output << player.name << " → " << teamName(userTeam->id) << " (₹" << player.price << " crore) [Priority]\n";
             continue;
         }
         
@@ -1766,7 +1872,7 @@ void IPLManager::simulateAuction() {
             // Each eligible team has a chance to bid based on their strategy
             std::vector<AITeam*> bidders;
             for (auto* team : eligibleTeams) {
-                float value = (player.battingRating + player.bowlingRating + player.fieldingRating) / 3.0f;
+                float value = player.ratings.Average();
                 float maxBid = player.price;
                 
                 switch (team->strategy) {
@@ -1780,12 +1886,12 @@ void IPLManager::simulateAuction() {
                         maxBid = std::min(value * 1.0f, MAX_BID);
                         break;
                     case AIStrategy::WILDCARD:
-                        maxBid = std::min(value * (1.0f + (rand() % 100) / 200.0f), MAX_BID);
+                        maxBid = std::min(value * (1.0f + (rng.NextIndex(100)) / 200.0f), MAX_BID);
                         break;
                 }
                 
                 if (currentBid + 0.5f <= maxBid && team->budget >= currentBid + 0.5f) {
-                    if (rand() % 100 < 70) { // 70% chance to bid
+                    if (rng.NextIndex(100) < 70) { // 70% chance to bid
                         bidders.push_back(team);
                     }
                 }
@@ -1795,7 +1901,7 @@ void IPLManager::simulateAuction() {
             
             // Randomly select a bidder
             std::uniform_int_distribution<> dis(0, bidders.size() - 1);
-            winner = bidders[dis(g)];
+            winner = bidders[dis(rng)];
             currentBid += 0.5f;
             
             // Remove other teams that didn't bid
@@ -1804,11 +1910,10 @@ void IPLManager::simulateAuction() {
         
         // Award player to winner
         if (winner) {
-            winner->squad.push_back(player);
+            winner->AddPlayer(player);
             winner->budget -= currentBid;
-            if (player.nationality == "Overseas") winner->overseasCount++;
             
-            std::cout << player.name << " → " << winner->team.name << " (₹" << currentBid << " crore)\n";
+            output << player.name << " → " << teamName(winner->id) << " (₹" << currentBid << " crore)\n";
         }
     }
     
@@ -1830,7 +1935,7 @@ void IPLManager::simulateAuction() {
     }
 
     // Function to generate a generic player of specific role
-    auto generateGenericPlayer = [](const std::string& role, const std::string& nationality) -> IPLPlayer {
+    auto generateGenericPlayer = [this](PlayerRole role, Nationality nationality) -> IPLPlayer {
         IPLPlayer player;
         
         // Use real names from the database
@@ -1844,33 +1949,33 @@ void IPLManager::simulateAuction() {
         
         // Select a real name based on nationality
         std::string selectedName;
-        if (nationality == "Indian") {
-            selectedName = indianNames[rand() % indianNames.size()];
+        if (nationality == Nationality::INDIAN) {
+            selectedName = indianNames[rng.NextIndex(indianNames.size())];
         } else {
-            selectedName = overseasNames[rand() % overseasNames.size()];
+            selectedName = overseasNames[rng.NextIndex(overseasNames.size())];
         }
         
         // Add a unique identifier to avoid duplicate names
-        selectedName += " " + std::to_string(rand() % 1000);
+        selectedName += " " + std::to_string(rng.NextIndex(1000));
         
         player.name = selectedName;
         player.role = role;
         player.nationality = nationality;
-        player.battingRating = 50 + rand() % 30; // 50-79
-        player.bowlingRating = 50 + rand() % 30; // 50-79
-        player.fieldingRating = 50 + rand() % 30; // 50-79
+        player.ratings.batting = 50 + rng.NextIndex(30); // 50-79
+        player.ratings.bowling = 50 + rng.NextIndex(30); // 50-79
+        player.ratings.fielding = 50 + rng.NextIndex(30); // 50-79
         player.price = 1.0f; // Base price
-        player.age = 20 + rand() % 15; // 20-34
+        player.age = 20 + rng.NextIndex(15); // 20-34
         
         // Assign batting approach based on role
-        if (role == "Batsman") {
-            player.battingApproach = "Balanced";
-        } else if (role == "All-rounder") {
-            player.battingApproach = "Balanced";
-        } else if (role == "Wicket-keeper") {
-            player.battingApproach = "Balanced";
+        if (role == PlayerRole::BATSMAN) {
+            player.battingApproach = BattingApproach::BALANCED;
+        } else if (role == PlayerRole::ALL_ROUNDER) {
+            player.battingApproach = BattingApproach::BALANCED;
+        } else if (role == PlayerRole::WICKET_KEEPER) {
+            player.battingApproach = BattingApproach::BALANCED;
         } else {
-            player.battingApproach = "Defensive";
+            player.battingApproach = BattingApproach::DEFENSIVE;
         }
         
         return player;
@@ -1878,10 +1983,10 @@ void IPLManager::simulateAuction() {
 
     // Ensure ALL teams meet requirements
     for (auto& ai : aiTeams) {
-        SquadStats stats = getSquadStats(ai);
+        const SquadStats& stats = ai.stats; // stays current as players are added
         
         // Helper to assign cheapest available player of a role
-        auto assignRole = [&](const std::string& role, int needed) {
+        auto assignRole = [&](PlayerRole role, int needed) {
             for (int i = 0; i < needed; ++i) {
                 // First try to find from unassigned players
                 auto it = std::min_element(unassignedPlayers.begin(), unassignedPlayers.end(), [&](const IPLPlayer& a, const IPLPlayer& b) {
@@ -1890,63 +1995,57 @@ void IPLManager::simulateAuction() {
                     return a.price < b.price;
                 });
                 
-                if (it != unassignedPlayers.end() && it->role == role && ai.squad.size() < 25 && ai.budget >= it->price && (it->nationality == "Indian" || ai.overseasCount < 8)) {
-                    ai.squad.push_back(*it);
+                if (it != unassignedPlayers.end() && it->role == role && ai.squad.size() < 25 && ai.budget >= it->price && (it->nationality == Nationality::INDIAN || ai.stats.overseas < 8)) {
+                    ai.AddPlayer(*it);
                     ai.budget -= it->price;
-                    if (it->nationality == "Overseas") ai.overseasCount++;
                     unassignedPlayers.erase(it);
-                    std::cout << it->name << " → " << ai.team.name << " (₹" << it->price << " crore) [Auto-assigned]\n";
+                    output << it->name << " → " << teamName(ai.id) << " (₹" << it->price << " crore) [Auto-assigned]\n";
                 } else {
                     // Generate generic player if no suitable player found
-                    std::string nationality = (ai.overseasCount < 8) ? "Overseas" : "Indian";
+                    Nationality nationality = (ai.stats.overseas < 8) ? Nationality::OVERSEAS : Nationality::INDIAN;
                     IPLPlayer genericPlayer = generateGenericPlayer(role, nationality);
-                    ai.squad.push_back(genericPlayer);
+                    ai.AddPlayer(genericPlayer);
                     ai.budget -= genericPlayer.price;
-                    if (genericPlayer.nationality == "Overseas") ai.overseasCount++;
-                    std::cout << genericPlayer.name << " → " << ai.team.name << " (₹" << genericPlayer.price << " crore) [Generated]\n";
+                    output << genericPlayer.name << " → " << teamName(ai.id) << " (₹" << genericPlayer.price << " crore) [Generated]\n";
                 }
             }
         };
         
         // Fill role requirements
-        if (stats.wicketKeepers < 1) assignRole("Wicket-keeper", 1 - stats.wicketKeepers);
-        if (stats.allRounders < 3) assignRole("All-rounder", 3 - stats.allRounders);
-        if (stats.bowlers < 5) assignRole("Bowler", 5 - stats.bowlers);
-        if (stats.batsmen < 5) assignRole("Batsman", 5 - stats.batsmen);
+        if (stats.wicketKeepers < 1) assignRole(PlayerRole::WICKET_KEEPER, 1 - stats.wicketKeepers);
+        if (stats.allRounders < 3) assignRole(PlayerRole::ALL_ROUNDER, 3 - stats.allRounders);
+        if (stats.bowlers < 5) assignRole(PlayerRole::BOWLER, 5 - stats.bowlers);
+        if (stats.batsmen < 5) assignRole(PlayerRole::BATSMAN, 5 - stats.batsmen);
         
         // Fill to minimum 18 players
-        stats = getSquadStats(ai);
         while (stats.totalPlayers < 18) {
             // Find cheapest available player
             auto it = std::min_element(unassignedPlayers.begin(), unassignedPlayers.end(), 
                 [](const IPLPlayer& a, const IPLPlayer& b) { return a.price < b.price; });
             
-            if (it != unassignedPlayers.end() && ai.squad.size() < 25 && ai.budget >= it->price && (it->nationality == "Indian" || ai.overseasCount < 8)) {
-                ai.squad.push_back(*it);
+            if (it != unassignedPlayers.end() && ai.squad.size() < 25 && ai.budget >= it->price && (it->nationality == Nationality::INDIAN || ai.stats.overseas < 8)) {
+                ai.AddPlayer(*it);
                 ai.budget -= it->price;
-                if (it->nationality == "Overseas") ai.overseasCount++;
                 unassignedPlayers.erase(it);
-                std::cout << it->name << " → " << ai.team.name << " (₹" << it->price << " crore) [Auto-assigned]\n";
+                output << it->name << " → " << teamName(ai.id) << " (₹" << it->price << " crore) [Auto-assigned]\n";
             } else {
                 // Generate generic player
-                std::string nationality = (ai.overseasCount < 8) ? "Overseas" : "Indian";
-                std::vector<std::string> roles = {"Batsman", "Bowler", "All-rounder"};
-                std::string role = roles[rand() % roles.size()];
+                Nationality nationality = (ai.stats.overseas < 8) ? Nationality::OVERSEAS : Nationality::INDIAN;
+                std::vector<PlayerRole> roles = {PlayerRole::BATSMAN, PlayerRole::BOWLER, PlayerRole::ALL_ROUNDER};
+                PlayerRole role = roles[rng.NextIndex(roles.size())];
                 IPLPlayer genericPlayer = generateGenericPlayer(role, nationality);
-                ai.squad.push_back(genericPlayer);
+                ai.AddPlayer(genericPlayer);
                 ai.budget -= genericPlayer.price;
-                if (genericPlayer.nationality == "Overseas") ai.overseasCount++;
-                std::cout << genericPlayer.name << " → " << ai.team.name << " (₹" << genericPlayer.price << " crore) [Generated]\n";
+                output << genericPlayer.name << " → " << teamName(ai.id) << " (₹" << genericPlayer.price << " crore) [Generated]\n";
             }
-            stats = getSquadStats(ai);
         }
     }
     
     // Display final squads
-    std::cout << "\n🏆 Auction Complete! Final Squads:\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Team                Squad  Overseas  Budget    Strategy  WK  AR  Bowl  Bat  Valid  ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "\n🏆 Auction Complete! Final Squads:\n";
+    output << "╔══════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n";
+    output << "║  Team                Squad  Overseas  Budget    Strategy  WK  AR  Bowl  Bat  Valid  ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
     
     for (const auto& ai : aiTeams) {
         std::string strategyName;
@@ -1957,14 +2056,14 @@ void IPLManager::simulateAuction() {
             case AIStrategy::WILDCARD: strategyName = "Wildcard"; break;
         }
         
-        SquadStats stats = getSquadStats(ai);
+        const SquadStats& stats = ai.stats;
         bool isValid = validateSquadRequirements(ai);
         std::string validStatus = isValid ? "✓" : "✗";
         
-        std::string marker = (ai.team.name == managerProfile.selectedTeam) ? "▶ " : "  ";
-        std::cout << "║  " << marker << std::left << std::setw(18) << ai.team.name
+        std::string marker = (ai.id == managerProfile.selectedTeam) ? "▶ " : "  ";
+        output << "║  " << marker << std::left << std::setw(18) << teamName(ai.id)
                   << std::setw(7) << ai.squad.size()
-                  << std::setw(10) << ai.overseasCount
+                  << std::setw(10) << ai.stats.overseas
                   << std::setw(10) << std::fixed << std::setprecision(1) << ai.budget
                   << std::setw(12) << strategyName
                   << std::setw(4) << stats.wicketKeepers
@@ -1973,7 +2072,7 @@ void IPLManager::simulateAuction() {
                   << std::setw(5) << stats.batsmen
                   << std::setw(6) << validStatus << " ║\n";
     }
-    std::cout << "╚══════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n";
+    output << "╚══════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n";
     
     // Check if all teams meet requirements
     bool allTeamsValid = true;
@@ -1985,126 +2084,114 @@ void IPLManager::simulateAuction() {
     }
     
     if (allTeamsValid) {
-        std::cout << "\n✅ All teams meet the minimum squad requirements!\n";
+        output << "\n✅ All teams meet the minimum squad requirements!\n";
     } else {
-        std::cout << "\n⚠️  Some teams do not meet the minimum squad requirements.\n";
-        std::cout << "Minimum requirements: 18+ players, 1+ WK, 3+ AR, 5+ Bowlers, 5+ Batsmen\n";
+        output << "\n⚠️  Some teams do not meet the minimum squad requirements.\n";
+        output << "Minimum requirements: 18+ players, 1+ WK, 3+ AR, 5+ Bowlers, 5+ Batsmen\n";
     }
     
     // Mark auction as complete
     auctionComplete = true;
-    std::cout << "\nType 5 to proceed to the season." << std::endl;
-    std::cout << "Enter your choice: ";
+    output << "\nType 5 to proceed to the season." << std::endl;
+    output << "Enter your choice: ";
 }
 
 void IPLManager::showAvailablePlayers() {
     printBanner("📊 AVAILABLE PLAYERS");
-    std::cout << "\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Name                Role      Nationality  Approach   Price   Rating          ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "\n";
+    output << "╔══════════════════════════════════════════════════════════════════════════════════╗\n";
+    output << "║  Name                Role      Nationality  Approach   Price   Rating          ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
     
     for (const auto& player : availablePlayers) {
-        float avgRating = (player.battingRating + player.bowlingRating + player.fieldingRating) / 3.0f;
-        std::cout << "║  " << std::left << std::setw(20) << player.name
-                  << std::setw(10) << player.role
-                  << std::setw(13) << player.nationality
-                  << std::setw(11) << player.battingApproach
+        float avgRating = player.ratings.Average();
+        output << "║  " << std::left << std::setw(20) << player.name
+                  << std::setw(10) << roleLabel(player.role)
+                  << std::setw(13) << nationalityLabel(player.nationality)
+                  << std::setw(11) << approachLabel(player.battingApproach)
                   << std::setw(8) << std::fixed << std::setprecision(1) << player.price
                   << std::setw(8) << std::fixed << std::setprecision(1) << avgRating << " ║\n";
     }
-    std::cout << "╚══════════════════════════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\nTotal available players: " << availablePlayers.size() << "\n";
-    std::cout << "\nPress Enter to continue...";
+    output << "╚══════════════════════════════════════════════════════════════════════════════════╝\n";
+    output << "\nTotal available players: " << availablePlayers.size() << "\n";
+    output << "\nPress Enter to continue...";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
 void IPLManager::showCurrentSquad() {
     printBanner("👥 CURRENT SQUAD");
-    std::cout << "\n";
+    output << "\n";
     
     // Find user's team
-    AITeam* userTeam = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == managerProfile.selectedTeam) {
-            userTeam = &ai;
-            break;
-        }
-    }
+    AITeam* userTeam = managerTeam();
     
     if (!userTeam) {
-        std::cout << "Team not found!\n";
+        output << "Team not found!\n";
         return;
     }
     
-    std::cout << "╔══════════════════════════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  " << std::left << std::setw(50) << managerProfile.selectedTeam << "║\n";
-    std::cout << "║  Budget: ₹" << std::fixed << std::setprecision(1) << std::setw(8) << userTeam->budget << " crore";
-    std::cout << "  Squad: " << userTeam->squad.size() << "/25";
-    std::cout << "  Overseas: " << userTeam->overseasCount << "/8" << std::setw(15) << " ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
-    std::cout << "║  Name                Role      Nationality  Approach   Price   Rating          ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "╔══════════════════════════════════════════════════════════════════════════════════╗\n";
+    output << "║  " << std::left << std::setw(50) << teamName(managerProfile.selectedTeam) << "║\n";
+    output << "║  Budget: ₹" << std::fixed << std::setprecision(1) << std::setw(8) << userTeam->budget << " crore";
+    output << "  Squad: " << userTeam->squad.size() << "/25";
+    output << "  Overseas: " << userTeam->stats.overseas << "/8" << std::setw(15) << " ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "║  Name                Role      Nationality  Approach   Price   Rating          ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════╣\n";
     
     for (const auto& player : userTeam->squad) {
-        float avgRating = (player.battingRating + player.bowlingRating + player.fieldingRating) / 3.0f;
-        std::cout << "║  " << std::left << std::setw(20) << player.name
-                  << std::setw(10) << player.role
-                  << std::setw(13) << player.nationality
-                  << std::setw(11) << player.battingApproach
+        float avgRating = player.ratings.Average();
+        output << "║  " << std::left << std::setw(20) << player.name
+                  << std::setw(10) << roleLabel(player.role)
+                  << std::setw(13) << nationalityLabel(player.nationality)
+                  << std::setw(11) << approachLabel(player.battingApproach)
                   << std::setw(8) << std::fixed << std::setprecision(1) << player.price
                   << std::setw(8) << std::fixed << std::setprecision(1) << avgRating << " ║\n";
     }
-    std::cout << "╚══════════════════════════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\nPress Enter to continue...";
+    output << "╚══════════════════════════════════════════════════════════════════════════════════╝\n";
+    output << "\nPress Enter to continue...";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
 void IPLManager::manualAuction() {
     printBanner("🎯 MANUAL AUCTION");
-    std::cout << "\n";
+    output << "\n";
     
     // User's team
-    AITeam* userTeam = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == managerProfile.selectedTeam) {
-            userTeam = &ai;
-            break;
-        }
-    }
+    AITeam* userTeam = managerTeam();
     if (!userTeam) return;
     
     // Auction pool (for demo, use availablePlayers)
     static size_t playerIndex = 0;
     if (playerIndex >= availablePlayers.size() || userTeam->squad.size() >= 25) {
         auctionComplete = true;
-        std::cout << "Auction complete!\n";
-        std::cout << "Type 'continue' to proceed to the season." << std::endl;
-        std::cout << "Enter your choice: ";
+        output << "Auction complete!\n";
+        output << "Type 'continue' to proceed to the season." << std::endl;
+        output << "Enter your choice: ";
         return;
     }
     IPLPlayer& player = availablePlayers[playerIndex];
     
     // Show player up for auction
-    std::cout << "\nPlayer up for auction: " << player.name << " (" << player.role << ", " << player.nationality << ")\n";
-    std::cout << "Batting Approach: " << player.battingApproach << "\n";
-    std::cout << "Base Price: ₹" << player.price << " crore\n";
+    output << "\nPlayer up for auction: " << player.name << " (" << roleLabel(player.role) << ", " << nationalityLabel(player.nationality) << ")\n";
+    output << "Batting Approach: " << approachLabel(player.battingApproach) << "\n";
+    output << "Base Price: ₹" << player.price << " crore\n";
     
     // Bidding
     float currentBid = player.price;
-    std::string currentBidder = "None";
-    std::map<std::string, bool> activeBidders;
+    FranchiseId currentBidder = NoFranchise;
+    std::vector<bool> activeBidders(aiTeams.size(), false);
     const float MAX_BID = 30.0f; // Maximum bid limit of ₹30 crore
     
     for (auto& ai : aiTeams) {
         // Only teams with squad < 25 and budget > base price can bid
         if (ai.squad.size() < 25 && ai.budget >= player.price) {
-            activeBidders[ai.team.name] = true;
+            activeBidders[ai.id] = true;
         }
     }
     // User always active if eligible
     if (userTeam->squad.size() < 25 && userTeam->budget >= player.price) {
-        activeBidders[userTeam->team.name] = true;
+        activeBidders[userTeam->id] = true;
     }
     
     bool userPassed = false;
@@ -2112,52 +2199,52 @@ void IPLManager::manualAuction() {
     while (true) {
         bool anyBid = false;
         for (auto& ai : aiTeams) {
-            if (!activeBidders[ai.team.name]) continue;
-            if (ai.team.name == userTeam->team.name) {
+            if (!activeBidders[ai.id]) continue;
+            if (ai.id == userTeam->id) {
                 // User's turn
                 if (userPassed) continue;
-                std::cout << "\nCurrent bid: ₹" << currentBid << " crore by " << currentBidder << std::endl;
-                std::cout << "Your budget: ₹" << userTeam->budget << " crore, Squad: " << userTeam->squad.size() << "/25, Overseas: " << userTeam->overseasCount << "/8" << std::endl;
+                output << "\nCurrent bid: ₹" << currentBid << " crore by " << (currentBidder == NoFranchise ? "None" : teamName(currentBidder)) << std::endl;
+                output << "Your budget: ₹" << userTeam->budget << " crore, Squad: " << userTeam->squad.size() << "/25, Overseas: " << userTeam->stats.overseas << "/8" << std::endl;
                 
                 // Show squad requirements
-                SquadStats stats = getSquadStats(*userTeam);
-                std::cout << "Squad: WK(" << stats.wicketKeepers << "/1) AR(" << stats.allRounders << "/3) Bowl(" << stats.bowlers << "/5) Bat(" << stats.batsmen << "/5)" << std::endl;
+                const SquadStats& stats = userTeam->stats;
+                output << "Squad: WK(" << stats.wicketKeepers << "/1) AR(" << stats.allRounders << "/3) Bowl(" << stats.bowlers << "/5) Bat(" << stats.batsmen << "/5)" << std::endl;
                 
                 // Check if next bid would exceed maximum
                 if (currentBid + 0.5f > MAX_BID) {
-                    std::cout << "Maximum bid limit of ₹" << MAX_BID << " crore reached!" << std::endl;
+                    output << "Maximum bid limit of ₹" << MAX_BID << " crore reached!" << std::endl;
                     userPassed = true;
-                    activeBidders[userTeam->team.name] = false;
+                    activeBidders[userTeam->id] = false;
                     continue;
                 }
                 
-                std::cout << "Do you want to bid ₹" << (currentBid + 0.5f) << " crore? (1=bid, 0=pass): ";
+                output << "Do you want to bid ₹" << (currentBid + 0.5f) << " crore? (1=bid, 0=pass): ";
                 std::string input;
                 std::getline(std::cin, input);
-                if (input == "1" && userTeam->budget >= currentBid + 0.5f && userTeam->squad.size() < 25 && (player.nationality == "Indian" || userTeam->overseasCount < 8)) {
+                if (input == "1" && userTeam->budget >= currentBid + 0.5f && userTeam->squad.size() < 25 && (player.nationality == Nationality::INDIAN || userTeam->stats.overseas < 8)) {
                     currentBid += 0.5f;
-                    currentBidder = userTeam->team.name;
+                    currentBidder = userTeam->id;
                     anyBid = true;
                 } else {
                     userPassed = true;
-                    activeBidders[userTeam->team.name] = false;
+                    activeBidders[userTeam->id] = false;
                 }
             } else {
                 // AI's turn
                 if (ai.squad.size() >= 25 || ai.budget < currentBid + 0.5f) {
-                    activeBidders[ai.team.name] = false;
+                    activeBidders[ai.id] = false;
                     continue;
                 }
                 
                 // Check if next bid would exceed maximum
                 if (currentBid + 0.5f > MAX_BID) {
-                    activeBidders[ai.team.name] = false;
+                    activeBidders[ai.id] = false;
                     continue;
                 }
                 
                 // AI logic based on strategy
                 bool aiBid = false;
-                float value = (player.battingRating + player.bowlingRating + player.fieldingRating) / 3.0f;
+                float value = player.ratings.Average();
                 float maxBid = player.price;
                 switch (ai.strategy) {
                     case AIStrategy::AGGRESSIVE:
@@ -2170,64 +2257,50 @@ void IPLManager::manualAuction() {
                         maxBid = std::min(value * 1.0f, MAX_BID);
                         break;
                     case AIStrategy::WILDCARD:
-                        maxBid = std::min(value * (1.0f + (rand() % 100) / 200.0f), MAX_BID);
+                        maxBid = std::min(value * (1.0f + (rng.NextIndex(100)) / 200.0f), MAX_BID);
                         break;
                 }
                 // AI only bids if under maxBid, has budget, and squad/overseas room
-                if (currentBid + 0.5f <= maxBid && ai.budget >= currentBid + 0.5f && ai.squad.size() < 25 && (player.nationality == "Indian" || ai.overseasCount < 8)) {
-                    if (rand() % 100 < 70) { // 70% chance to bid if eligible
+                if (currentBid + 0.5f <= maxBid && ai.budget >= currentBid + 0.5f && ai.squad.size() < 25 && (player.nationality == Nationality::INDIAN || ai.stats.overseas < 8)) {
+                    if (rng.NextIndex(100) < 70) { // 70% chance to bid if eligible
                         currentBid += 0.5f;
-                        currentBidder = ai.team.name;
+                        currentBidder = ai.id;
                         anyBid = true;
-                        std::cout << ai.team.name << " bids ₹" << currentBid << " crore!\n";
+                        output << teamName(ai.id) << " bids ₹" << currentBid << " crore!\n";
                     } else {
-                        activeBidders[ai.team.name] = false;
-                        std::cout << ai.team.name << " passes.\n";
+                        activeBidders[ai.id] = false;
+                        output << teamName(ai.id) << " passes.\n";
                     }
                 } else {
-                    activeBidders[ai.team.name] = false;
-                    std::cout << ai.team.name << " passes.\n";
+                    activeBidders[ai.id] = false;
+                    output << teamName(ai.id) << " passes.\n";
                 }
             }
         }
         // If only one bidder left, award player
         int biddersLeft = 0;
-        std::string winner;
-        for (const auto& [name, active] : activeBidders) {
-            if (active) {
+        FranchiseId winner = NoFranchise;
+        for (FranchiseId id = 0; id < activeBidders.size(); ++id) {
+            if (activeBidders[id]) {
                 biddersLeft++;
-                winner = name;
+                winner = id;
             }
         }
         if (biddersLeft <= 1) {
-            if (winner.empty()) winner = currentBidder;
-            std::cout << "\nPlayer " << player.name << " sold to " << winner << " for ₹" << currentBid << " crore!\n";
+            if (winner == NoFranchise) winner = currentBidder;
+            output << "\nPlayer " << player.name << " sold to " << (winner == NoFranchise ? "None" : teamName(winner)) << " for ₹" << currentBid << " crore!\n";
             // Add player to winner's squad
-            for (auto& ai : aiTeams) {
-                if (ai.team.name == winner) {
-                    ai.squad.push_back(player);
-                    ai.budget -= currentBid;
-                    if (player.nationality == "Overseas") ai.overseasCount++;
-                    break;
-                }
-            }
-            // If user won, update userTeam pointer
-            if (winner == userTeam->team.name) {
-                userTeam = nullptr;
-                for (auto& ai : aiTeams) {
-                    if (ai.team.name == managerProfile.selectedTeam) {
-                        userTeam = &ai;
-                        break;
-                    }
-                }
+            if (winner != NoFranchise) {
+                aiTeams[winner].AddPlayer(player);
+                aiTeams[winner].budget -= currentBid;
             }
             break;
         }
         if (!anyBid) break; // No more bids
     }
     playerIndex++;
-    std::cout << "\nType 'continue' to auction next player or 'back' to exit auction." << std::endl;
-    std::cout << "Enter your choice: ";
+    output << "\nType 'continue' to auction next player or 'back' to exit auction." << std::endl;
+    output << "Enter your choice: ";
 }
 
 // Avatar and Logo helpers
@@ -2274,24 +2347,124 @@ std::string IPLManager::getManagerAvatar() {
 
 void IPLManager::simulateEntireSeason() {
     printBanner("🏁 SIMULATING ENTIRE SEASON");
-    std::cout << "\nSimulating all matches...\n\n";
+    output << "\nSimulating all matches...\n\n";
     generateSeasonFixtures();
+    
+    // Each fixture goes in the first round where neither team is playing yet
+    std::vector<std::vector<Match*>> rounds;
+    std::vector<std::vector<bool>> playing;
     for (auto& match : seasonFixtures) {
-        simulateMatch(match);
+        size_t round = 0;
+        while (round < rounds.size() && (playing[round][match.team1] || playing[round][match.team2])) {
+            ++round;
+        }
+        if (round == rounds.size()) {
+            rounds.emplace_back();
+            playing.emplace_back(iplTeams.size(), false);
+        }
+        rounds[round].push_back(&match);
+        playing[round][match.team1] = true;
+        playing[round][match.team2] = true;
+    }
+    for (size_t round = 0; round < rounds.size(); ++round) {
+        output << "\n── Round " << round + 1 << " ──\n";
+        simulateRound(rounds[round]);
     }
     updateLeagueTable();
-    std::cout << "\nAll matches completed!\n\n";
+    output << "\nAll matches completed!\n\n";
     showLeagueTable();
-    std::cout << "\nPress Enter to return to main menu...";
+    output << "\nPress Enter to return to main menu...";
     std::cin.get();
     currentState = GameState::MAIN_MENU;
 }
 
+// Fixtures are independent given fixed squads and each has its own stream,
+// so the round's matches play concurrently into buffers. The manager's own
+// fixture needs the keyboard and plays live on this thread. Output and the
+// table are updated in fixture order either way.
+void IPLManager::simulateRound(const std::vector<Match*>& round) {
+    auto isManagerFixture = [this](const Match& match) {
+        return match.team1 == managerProfile.selectedTeam || match.team2 == managerProfile.selectedTeam;
+    };
+    
+    std::vector<size_t> background;
+    for (size_t i = 0; i < round.size(); ++i) {
+        if (!isManagerFixture(*round[i])) {
+            background.push_back(i);
+        }
+    }
+    
+    std::vector<std::ostringstream> buffers(round.size());
+    std::vector<std::exception_ptr> failures(round.size());
+    std::vector<char> finished(round.size(), 0);
+    std::atomic<size_t> nextJob{0};
+    std::atomic<bool> abandoned{false};
+    std::mutex finishedMutex;
+    std::condition_variable finishedSignal;
+    auto worker = [&]() {
+        for (size_t job = nextJob++; job < background.size() && !abandoned; job = nextJob++) {
+            size_t i = background[job];
+            // A failed fixture still counts as finished so the round never waits on it
+            try {
+                playMatch(*round[i], buffers[i]);
+            } catch (...) {
+                failures[i] = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                finished[i] = 1;
+            }
+            finishedSignal.notify_one();
+        }
+    };
+    
+    // Workers stop taking fixtures and are joined however the round ends
+    struct JoinOnExit {
+        std::vector<std::thread>& threads;
+        std::atomic<bool>& abandoned;
+        ~JoinOnExit() {
+            abandoned = true;
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+    };
+    
+    std::exception_ptr failure;
+    {
+        std::vector<std::thread> threads;
+        JoinOnExit joinOnExit{threads, abandoned};
+        size_t numThreads = std::min<size_t>(background.size(), std::max(1u, std::thread::hardware_concurrency()));
+        for (size_t t = 0; t < numThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+        
+        for (size_t i = 0; i < round.size(); ++i) {
+            if (isManagerFixture(*round[i])) {
+                playMatch(*round[i], output);
+            } else {
+                std::unique_lock<std::mutex> lock(finishedMutex);
+                finishedSignal.wait(lock, [&]() { return finished[i] != 0; });
+                lock.unlock();
+                if (failures[i]) {
+                    failure = failures[i];
+                    break;
+                }
+                output << buffers[i].str();
+            }
+            recordResult(*round[i]);
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
 // Helper: Get available bowlers for a team (max 4 overs per bowler)
 std::vector<IPLPlayer*> IPLManager::getAvailableBowlers(AITeam& team, std::map<std::string, int>& bowlerOvers) {
     std::vector<IPLPlayer*> bowlers;
     for (auto& player : team.squad) {
-        if ((player.role == "Bowler" || player.role == "All-rounder") && bowlerOvers[player.name] < 4) {
+        if ((player.role == PlayerRole::BOWLER || player.role == PlayerRole::ALL_ROUNDER) && bowlerOvers[player.name] < 4) {
             bowlers.push_back(&player);
         }
     }
@@ -2302,22 +2475,22 @@ std::vector<IPLPlayer*> IPLManager::getAvailableBowlers(AITeam& team, std::map<s
 std::vector<IPLPlayer*> IPLManager::createBattingOrder(AITeam& team) {
     std::vector<IPLPlayer*> battingOrder;
     for (auto& player : team.squad) {
-        if (player.battingApproach == "Aggressive") {
+        if (player.battingApproach == BattingApproach::AGGRESSIVE) {
             battingOrder.push_back(&player);
         }
     }
     for (auto& player : team.squad) {
-        if (player.battingApproach == "Balanced") {
+        if (player.battingApproach == BattingApproach::BALANCED) {
             battingOrder.push_back(&player);
         }
     }
     for (auto& player : team.squad) {
-        if (player.battingApproach == "Defensive") {
+        if (player.battingApproach == BattingApproach::DEFENSIVE) {
             battingOrder.push_back(&player);
         }
     }
     for (auto& player : team.squad) {
-        if (player.battingApproach == "Attacking") {
+        if (player.battingApproach == BattingApproach::ATTACKING) {
             battingOrder.push_back(&player);
         }
     }
@@ -2326,108 +2499,128 @@ std::vector<IPLPlayer*> IPLManager::createBattingOrder(AITeam& team) {
 
 // Helper: Auto-simulate matches not involving manager's team
 void IPLManager::autoSimulateOtherMatches() {
-    std::cout << "\n🏏 Auto-simulating other matches...\n";
+    output << "\n🏏 Auto-simulating other matches...\n";
     
     for (auto& match : seasonFixtures) {
         if (!match.isPlayed && match.team1 != managerProfile.selectedTeam && match.team2 != managerProfile.selectedTeam) {
-            std::cout << "Simulating: " << match.team1 << " vs " << match.team2 << "... ";
-            
-            // Quick simulation without detailed commentary
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> scoreDist(120, 200);
-            std::uniform_int_distribution<> wicketDist(5, 10);
-            
-            match.team1Score = scoreDist(gen);
-            match.team2Score = scoreDist(gen);
-            match.isPlayed = true;
-            
-            if (match.team1Score > match.team2Score) {
-                match.winner = match.team1;
-                std::cout << match.team1 << " wins by " << (match.team1Score - match.team2Score) << " runs\n";
-            } else if (match.team2Score > match.team1Score) {
-                match.winner = match.team2;
-                std::cout << match.team2 << " wins by " << (match.team2Score - match.team1Score) << " runs\n";
-            } else {
-                match.winner = "Tie";
-                std::cout << "Match tied!\n";
-            }
-            
-            // Update team stats
-            for (auto& team : iplTeams) {
-                if (team.name == match.team1) {
-                    if (match.winner == match.team1) {
-                        team.wins++;
-                        team.points += 2;
-                    } else if (match.winner == "Tie") {
-                        team.ties++;
-                        team.points += 1;
-                    } else {
-                        team.losses++;
-                    }
-                } else if (team.name == match.team2) {
-                    if (match.winner == match.team2) {
-                        team.wins++;
-                        team.points += 2;
-                    } else if (match.winner == "Tie") {
-                        team.ties++;
-                        team.points += 1;
-                    } else {
-                        team.losses++;
-                    }
-                }
-            }
+            output << "Simulating: " << teamName(match.team1) << " vs " << teamName(match.team2) << "... ";
+            output << simulateEngineMatch(match, static_cast<uint32_t>(&match - seasonFixtures.data()), false) << "\n";
+            recordResult(match);
         }
     }
-    std::cout << "Auto-simulation complete!\n\n";
+    output << "Auto-simulation complete!\n\n";
+}
+
+// Helper: Play a fixture on the engine's score-only path
+std::string IPLManager::simulateEngineMatch(Match& match, uint32_t matchIndex, bool superOver) {
+    // Real engine on the score-only fast path: same model, no commentary
+    std::unique_ptr<Team> team1 = buildEngineTeam(aiTeams[match.team1]);
+    std::unique_ptr<Team> team2 = buildEngineTeam(aiTeams[match.team2]);
+    Venue venue(match.venue, teamName(match.team1), VenueType::STADIUM);
+    MatchEngine engine;
+    engine.SetSimulationFidelity(SimulationFidelity::SCORE_ONLY);
+    engine.InitializeMatch(team1.get(), team2.get(), &venue, MatchType::T20);
+    engine.EnableSuperOver(superOver);
+    engine.SetMatchIndex(seasonIndex << 8 | matchIndex);
+    engine.SimulateMatch();
+    
+    match.team1Score = engine.GetInningsTotals(0).runs;
+    match.team2Score = engine.GetInningsTotals(1).runs;
+    match.isPlayed = true;
+    
+    TeamId winner = engine.GetMatchState().winner;
+    if (winner == 0) {
+        match.winner = match.team1;
+    } else if (winner == 1) {
+        match.winner = match.team2;
+    } else {
+        match.winner = NoFranchise;
+    }
+    return engine.GetResultDescription();
+}
+
+// Helper: Build an engine Team from an AI squad
+std::unique_ptr<Team> IPLManager::buildEngineTeam(const AITeam& team) {
+    auto engineTeam = std::make_unique<Team>(teamName(team.id), TeamType::FRANCHISE);
+    
+    // Best eleven by combined rating, then bat them in order of batting rating
+    std::vector<const IPLPlayer*> eleven;
+    for (const auto& player : team.squad) {
+        eleven.push_back(&player);
+    }
+    std::sort(eleven.begin(), eleven.end(), [](const IPLPlayer* a, const IPLPlayer* b) {
+        return a->ratings.batting + a->ratings.bowling > b->ratings.batting + b->ratings.bowling;
+    });
+    if (eleven.size() > 11) {
+        eleven.resize(11);
+    }
+    std::stable_sort(eleven.begin(), eleven.end(), [](const IPLPlayer* a, const IPLPlayer* b) {
+        return a->ratings.batting > b->ratings.batting;
+    });
+    
+    std::vector<std::string> names;
+    for (const IPLPlayer* player : eleven) {
+        auto enginePlayer = std::make_unique<Player>(player->name, player->age, player->role);
+        PlayerAttributes& attributes = enginePlayer->GetPlayerAttributes();
+        int batting = static_cast<int>(player->ratings.batting);
+        int bowling = static_cast<int>(player->ratings.bowling);
+        int fielding = static_cast<int>(player->ratings.fielding);
+        attributes.battingTechnique = attributes.battingPower = batting;
+        attributes.battingTiming = attributes.battingConcentration = batting;
+        attributes.bowlingAccuracy = attributes.bowlingPace = bowling;
+        attributes.bowlingSpin = attributes.bowlingVariation = bowling;
+        attributes.fielding = attributes.throwing = attributes.catching = fielding;
+        if (player->battingApproach == BattingApproach::AGGRESSIVE) attributes.battingAggression = 80;
+        else if (player->battingApproach == BattingApproach::ATTACKING) attributes.battingAggression = 70;
+        else if (player->battingApproach == BattingApproach::DEFENSIVE) attributes.battingAggression = 30;
+        
+        names.push_back(player->name);
+        engineTeam->AddPlayer(std::move(enginePlayer));
+    }
+    engineTeam->SetPlayingXI(names);
+    return engineTeam;
 }
 
 // Helper: Show squad with detailed information
 void IPLManager::showDetailedSquad() {
     printBanner("👥 DETAILED SQUAD VIEW");
-    std::cout << "\n";
+    output << "\n";
     
     // Find user's team
-    AITeam* userTeam = nullptr;
-    for (auto& ai : aiTeams) {
-        if (ai.team.name == managerProfile.selectedTeam) {
-            userTeam = &ai;
-            break;
-        }
-    }
+    AITeam* userTeam = managerTeam();
     
     if (!userTeam) {
-        std::cout << "Team not found!\n";
+        output << "Team not found!\n";
         return;
     }
     
-    std::cout << "╔══════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  " << std::left << std::setw(50) << managerProfile.selectedTeam << "║\n";
-    std::cout << "║  Budget: ₹" << std::fixed << std::setprecision(1) << std::setw(8) << userTeam->budget << " crore";
-    std::cout << "  Squad: " << userTeam->squad.size() << "/25";
-    std::cout << "  Overseas: " << userTeam->overseasCount << "/8" << std::setw(15) << " ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
-    std::cout << "║  Name                Role      Nationality  Approach   Age   Bat   Bowl  Field  Price   Overall Rating      ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "╔══════════════════════════════════════════════════════════════════════════════════════════════════════════════╗\n";
+    output << "║  " << std::left << std::setw(50) << teamName(managerProfile.selectedTeam) << "║\n";
+    output << "║  Budget: ₹" << std::fixed << std::setprecision(1) << std::setw(8) << userTeam->budget << " crore";
+    output << "  Squad: " << userTeam->squad.size() << "/25";
+    output << "  Overseas: " << userTeam->stats.overseas << "/8" << std::setw(15) << " ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
+    output << "║  Name                Role      Nationality  Approach   Age   Bat   Bowl  Field  Price   Overall Rating      ║\n";
+    output << "╠══════════════════════════════════════════════════════════════════════════════════════════════════════════════╣\n";
     
     for (const auto& player : userTeam->squad) {
-        float avgRating = (player.battingRating + player.bowlingRating + player.fieldingRating) / 3.0f;
-        std::cout << "║  " << std::left << std::setw(20) << player.name
-                  << std::setw(10) << player.role
-                  << std::setw(13) << player.nationality
-                  << std::setw(11) << player.battingApproach
-                  << std::setw(6) << player.age
-                  << std::setw(6) << std::fixed << std::setprecision(0) << player.battingRating
-                  << std::setw(7) << std::fixed << std::setprecision(0) << player.bowlingRating
-                  << std::setw(7) << std::fixed << std::setprecision(0) << player.fieldingRating
+        float avgRating = player.ratings.Average();
+        output << "║  " << std::left << std::setw(20) << player.name
+                  << std::setw(10) << roleLabel(player.role)
+                  << std::setw(13) << nationalityLabel(player.nationality)
+                  << std::setw(11) << approachLabel(player.battingApproach)
+                  << std::setw(6) << static_cast<int>(player.age)
+                  << std::setw(6) << std::fixed << std::setprecision(0) << static_cast<int>(player.ratings.batting)
+                  << std::setw(7) << std::fixed << std::setprecision(0) << static_cast<int>(player.ratings.bowling)
+                  << std::setw(7) << std::fixed << std::setprecision(0) << static_cast<int>(player.ratings.fielding)
                   << std::setw(8) << std::fixed << std::setprecision(1) << player.price
                   << std::setw(8) << std::fixed << std::setprecision(1) << avgRating << " ║\n";
     }
-    std::cout << "╚══════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n";
+    output << "╚══════════════════════════════════════════════════════════════════════════════════════════════════════════════╝\n";
     
     // Show team statistics
-    std::cout << "\n📊 TEAM STATISTICS:\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "\n📊 TEAM STATISTICS:\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
     
     // Count players by role
     int batsmen = 0, bowlers = 0, allRounders = 0, wicketKeepers = 0;
@@ -2435,69 +2628,69 @@ void IPLManager::showDetailedSquad() {
     float totalBattingRating = 0, totalBowlingRating = 0, totalFieldingRating = 0;
     
     for (const auto& player : userTeam->squad) {
-        if (player.role == "Batsman") batsmen++;
-        else if (player.role == "Bowler") bowlers++;
-        else if (player.role == "All-rounder") allRounders++;
-        else if (player.role == "Wicket-keeper") wicketKeepers++;
+        if (player.role == PlayerRole::BATSMAN) batsmen++;
+        else if (player.role == PlayerRole::BOWLER) bowlers++;
+        else if (player.role == PlayerRole::ALL_ROUNDER) allRounders++;
+        else if (player.role == PlayerRole::WICKET_KEEPER) wicketKeepers++;
         
-        if (player.nationality == "Indian") indians++;
+        if (player.nationality == Nationality::INDIAN) indians++;
         else overseas++;
         
-        totalBattingRating += player.battingRating;
-        totalBowlingRating += player.bowlingRating;
-        totalFieldingRating += player.fieldingRating;
+        totalBattingRating += player.ratings.batting;
+        totalBowlingRating += player.ratings.bowling;
+        totalFieldingRating += player.ratings.fielding;
     }
     
     float avgBatting = totalBattingRating / userTeam->squad.size();
     float avgBowling = totalBowlingRating / userTeam->squad.size();
     float avgFielding = totalFieldingRating / userTeam->squad.size();
     
-    std::cout << "║  Role Distribution:                                    ║\n";
-    std::cout << "║    Batsmen: " << std::setw(3) << batsmen << "    Bowlers: " << std::setw(3) << bowlers 
+    output << "║  Role Distribution:                                    ║\n";
+    output << "║    Batsmen: " << std::setw(3) << batsmen << "    Bowlers: " << std::setw(3) << bowlers 
               << "    All-rounders: " << std::setw(3) << allRounders << "    Wicket-keepers: " << std::setw(3) << wicketKeepers << " ║\n";
-    std::cout << "║  Nationality: Indians " << std::setw(3) << indians << "    Overseas " << std::setw(3) << overseas << "                    ║\n";
-    std::cout << "║  Average Ratings: Bat " << std::fixed << std::setprecision(1) << std::setw(5) << avgBatting 
+    output << "║  Nationality: Indians " << std::setw(3) << indians << "    Overseas " << std::setw(3) << overseas << "                    ║\n";
+    output << "║  Average Ratings: Bat " << std::fixed << std::setprecision(1) << std::setw(5) << avgBatting 
               << "    Bowl " << std::setw(5) << avgBowling << "    Field " << std::setw(5) << avgFielding << "        ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
     
     // Check minimum requirements
     bool meetsRequirements = validateSquadRequirements(*userTeam);
-    std::cout << "\n📋 MINIMUM REQUIREMENTS STATUS:\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║  Requirement                    Required  Current  Status    ║\n";
-    std::cout << "╠══════════════════════════════════════════════════════════════╣\n";
-    std::cout << "║  Total Players                  ≥18       " << std::setw(7) << userTeam->squad.size() 
+    output << "\n📋 MINIMUM REQUIREMENTS STATUS:\n";
+    output << "╔══════════════════════════════════════════════════════════════╗\n";
+    output << "║  Requirement                    Required  Current  Status    ║\n";
+    output << "╠══════════════════════════════════════════════════════════════╣\n";
+    output << "║  Total Players                  ≥18       " << std::setw(7) << userTeam->squad.size() 
               << "  " << (userTeam->squad.size() >= 18 ? "✓" : "✗") << "        ║\n";
-    std::cout << "║  Wicket-keepers                 ≥1        " << std::setw(7) << wicketKeepers 
+    output << "║  Wicket-keepers                 ≥1        " << std::setw(7) << wicketKeepers 
               << "  " << (wicketKeepers >= 1 ? "✓" : "✗") << "        ║\n";
-    std::cout << "║  All-rounders                   ≥3        " << std::setw(7) << allRounders 
+    output << "║  All-rounders                   ≥3        " << std::setw(7) << allRounders 
               << "  " << (allRounders >= 3 ? "✓" : "✗") << "        ║\n";
-    std::cout << "║  Bowlers                        ≥5        " << std::setw(7) << bowlers 
+    output << "║  Bowlers                        ≥5        " << std::setw(7) << bowlers 
               << "  " << (bowlers >= 5 ? "✓" : "✗") << "        ║\n";
-    std::cout << "║  Batsmen                        ≥5        " << std::setw(7) << batsmen 
+    output << "║  Batsmen                        ≥5        " << std::setw(7) << batsmen 
               << "  " << (batsmen >= 5 ? "✓" : "✗") << "        ║\n";
-    std::cout << "║  Overseas Players               ≤8        " << std::setw(7) << overseas 
+    output << "║  Overseas Players               ≤8        " << std::setw(7) << overseas 
               << "  " << (overseas <= 8 ? "✓" : "✗") << "        ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
+    output << "╚══════════════════════════════════════════════════════════════╝\n";
     
     if (meetsRequirements) {
-        std::cout << "\n✅ Squad meets all minimum requirements!\n";
+        output << "\n✅ Squad meets all minimum requirements!\n";
     } else {
-        std::cout << "\n⚠️  Squad does not meet all minimum requirements.\n";
+        output << "\n⚠️  Squad does not meet all minimum requirements.\n";
     }
     
-    std::cout << "\nPress Enter to continue...";
+    output << "\nPress Enter to continue...";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
 // Helper: Select player using arrow keys
 IPLPlayer* IPLManager::selectPlayerWithArrows(const std::vector<IPLPlayer*>& players, const std::string& title) {
     if (players.empty()) return nullptr;
-    std::cout << "\n" << title << "\n";
+    output << "\n" << title << "\n";
     for (size_t i = 0; i < players.size(); ++i) {
-        std::cout << "  " << (i+1) << ". " << players[i]->name << " (" << players[i]->role << ", " << players[i]->battingApproach << ")\n";
+        output << "  " << (i+1) << ". " << players[i]->name << " (" << roleLabel(players[i]->role) << ", " << approachLabel(players[i]->battingApproach) << ")\n";
     }
-    std::cout << "Enter number to select, or 0 to cancel: ";
+    output << "Enter number to select, or 0 to cancel: ";
     std::string input;
     std::getline(std::cin, input);
     int idx = std::stoi(input);
@@ -2541,7 +2734,7 @@ int IPLManager::getArrowKeyInput() {
 
 // Helper: Validate team squad requirements
 bool IPLManager::validateSquadRequirements(const AITeam& team) {
-    SquadStats stats = getSquadStats(team);
+    const SquadStats& stats = team.stats;
     
     // Check minimum squad size
     if (stats.totalPlayers < 18) {
@@ -2570,32 +2763,36 @@ bool IPLManager::validateSquadRequirements(const AITeam& team) {
     return true;
 }
 
-// Helper: Get team squad statistics
-IPLManager::SquadStats IPLManager::getSquadStats(const AITeam& team) {
-    SquadStats stats;
-    stats.totalPlayers = team.squad.size();
-    stats.wicketKeepers = 0;
-    stats.allRounders = 0;
-    stats.bowlers = 0;
-    stats.batsmen = 0;
-    stats.indians = 0;
-    stats.overseas = 0;
-    
-    for (const auto& player : team.squad) {
-        if (player.role == "Wicket-keeper") stats.wicketKeepers++;
-        else if (player.role == "All-rounder") stats.allRounders++;
-        else if (player.role == "Bowler") stats.bowlers++;
-        else if (player.role == "Batsman") stats.batsmen++;
-        
-        if (player.nationality == "Indian") stats.indians++;
-        else stats.overseas++;
-    }
-    
-    return stats;
-}
-
 int main(int argc, char* argv[]) {
     try {
+        // Headless batch mode: --simulate-seasons N [--threads T] [--seed S] [--out FILE]
+        IPLManager::HeadlessOptions options;
+        bool headless = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--simulate-seasons" && hasValue) {
+                options.seasons = std::stoi(argv[++i]);
+                headless = true;
+            } else if (arg == "--threads" && hasValue) {
+                options.threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--seed" && hasValue) {
+                RandomService::SetSeed(std::stoull(argv[++i]));
+            } else if (arg == "--out" && hasValue) {
+                options.outPath = argv[++i];
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--simulate-seasons N [--threads T] [--seed S] [--out FILE]]" << std::endl;
+                return 1;
+            }
+        }
+        if (headless) {
+            if (options.seasons < 1) {
+                std::cerr << "--simulate-seasons needs at least one season" << std::endl;
+                return 1;
+            }
+            return IPLManager::runHeadless(options);
+        }
+        
         // Create and initialize the IPL Manager
         IPLManager game;
         